@@ -1,3 +1,8 @@
 #!/bin/bash
 
-gcc -o build/alizadeh.exe src/*.c -lm -g && ./build/alizadeh.exe "$@"
\ No newline at end of file
+# The compression libraries used by the --compress option are optional.
+compression_flags=""
+echo "#include<zlib.h>" | gcc -E - > /dev/null 2>&1 && compression_flags="$compression_flags -DHAVE_ZLIB -lz"
+echo "#include<zstd.h>" | gcc -E - > /dev/null 2>&1 && compression_flags="$compression_flags -DHAVE_ZSTD -lzstd"
+
+gcc -o build/alizadeh.exe src/*.c -lm -pthread -g $compression_flags && ./build/alizadeh.exe "$@"
@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# Consistency checks between execution paths that must produce identical results, and of the distribution of the random draws.
+# Prints PASSED or FAILED for each check and exits with the number of failed checks.
+
+# Prints the provided text in the given color.
+# $1 Sequence code of the chosen color.
+# $2 The string to be printed.
+print_in_color()
+{
+    echo -e "$1$2\033[0m"
+}
+
+# Compares two files byte by byte, printing the result of the check.
+# $1 Name of the check.
+# $2 First file.
+# $3 Second file.
+compare_outputs()
+{
+    if cmp -s "$2" "$3"; then
+        print_in_color "\033[0;32m" "PASSED: $1"
+    else
+        print_in_color "\033[0;31m" "FAILED: $1"
+        failed_checks=$((failed_checks + 1))
+    fi
+}
+
+dir_name="checks"
+mkdir -p output/$dir_name
+failed_checks=0
+
+gcc -o build/alizadeh.exe src/*.c -lm -pthread -g || exit 1
+
+print_in_color "\033[0;34m" "Heatmap of the simulations advanced together (--batch-seeds) against the sequential simulations."
+for load_method in "-ealizadeh_crowd.txt -m4" "-ealizadeh_classroom.txt -m2 -p40"; do
+    ./build/alizadeh.exe $load_method -O3 -s7 --heatmap-encoding=binary --common-random-numbers -o$dir_name/heatmap_sequential.bin > /dev/null
+    ./build/alizadeh.exe $load_method -O3 -s7 --heatmap-encoding=binary --common-random-numbers --batch-seeds=3 -o$dir_name/heatmap_batch.bin > /dev/null
+    compare_outputs "batch heatmap ($load_method)" output/$dir_name/heatmap_sequential.bin output/$dir_name/heatmap_batch.bin
+done
+
+print_in_color "\033[0;34m" "Heatmap of the parallel timestep (--parallel-timestep) against the sequential timestep."
+for load_method in "-ealizadeh_crowd.txt -m4" "-ealizadeh_classroom.txt -m2 -p40"; do
+    for x_movement in "" "--allow-x-movement"; do
+        ./build/alizadeh.exe $load_method $x_movement -O3 -s7 --heatmap-encoding=binary --common-random-numbers -o$dir_name/heatmap_sequential.bin > /dev/null
+        for num_threads in 2 4; do
+            ./build/alizadeh.exe $load_method $x_movement -O3 -s7 --heatmap-encoding=binary --common-random-numbers --parallel-timestep --threads=$num_threads -o$dir_name/heatmap_parallel.bin > /dev/null
+            compare_outputs "parallel timestep heatmap ($load_method${x_movement:+ $x_movement} --threads=$num_threads)" output/$dir_name/heatmap_sequential.bin output/$dir_name/heatmap_parallel.bin
+        done
+    done
+done
+
+print_in_color "\033[0;34m" "Heatmap of the grid layouts and the parallel calculations of the exit grids against the row-major layout."
+for simulation_sets in "-evaras_classroom_with_obstacles.txt -avaras_optimal_location.txt -m3" "-evaras_classroom_2_with_obstacles.txt -avaras_double_doors.txt -m3 --alpha=0.3"; do
+    ./build/alizadeh.exe $simulation_sets -O3 -s2 --heatmap-encoding=binary --common-random-numbers -o$dir_name/heatmap_row_major.bin > /dev/null
+    for grid_option in "--grid-layout=tiled" "--grid-layout=sparse" "--static-field-cache" "--parallel-field-cells=1 --threads=4" "--parallel-exit-cells=1 --threads=4"; do
+        ./build/alizadeh.exe $simulation_sets $grid_option -O3 -s2 --heatmap-encoding=binary --common-random-numbers -o$dir_name/heatmap_grid_option.bin > /dev/null
+        compare_outputs "grid option heatmap ($simulation_sets $grid_option)" output/$dir_name/heatmap_row_major.bin output/$dir_name/heatmap_grid_option.bin
+    done
+done
+
+print_in_color "\033[0;34m" "Cells of the randomly placed pedestrians against the exits of each simulation set."
+# The exits given by --exit-sets aren't walls, and 63 pedestrians fill every other cell of the room, so only the exit cell of each set must be left free.
+./build/alizadeh.exe -l10 -c10 -m5 -p63 --exit-sets="4 4. 5 5." -O1 -s3 --max-timesteps=1 -o$dir_name/placement.txt > /dev/null
+sed 's/👤/p/g; s/🚪/_/g; s/🧱/#/g; s/⬛/./g' output/$dir_name/placement.txt |
+    awk '/timestep 0$/ {frame++; row = -1; next} {exit_cell = frame <= 3 ? 4 : 5; if(row == exit_cell) print substr($0, exit_cell + 1, 1); row++}' > output/$dir_name/placement_exits.txt
+if [ "$(wc -l < output/$dir_name/placement_exits.txt)" -eq 6 ] && ! grep -q p output/$dir_name/placement_exits.txt; then
+    print_in_color "\033[0;32m" "PASSED: pedestrians placed out of the exits"
+else
+    print_in_color "\033[0;31m" "FAILED: pedestrians placed out of the exits"
+    failed_checks=$((failed_checks + 1))
+fi
+
+print_in_color "\033[0;34m" "Gaps between the panics of the countdown against the per-timestep Bernoulli draws."
+if gcc -o build/panic_gaps.exe tools/panic_gaps.c src/random_stream.c src/cli_processing.c src/shared_resources.c -lm -g && ./build/panic_gaps.exe; then
+    print_in_color "\033[0;32m" "PASSED: panic gaps"
+else
+    print_in_color "\033[0;31m" "FAILED: panic gaps"
+    failed_checks=$((failed_checks + 1))
+fi
+
+exit $failed_checks
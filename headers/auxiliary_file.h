@@ -0,0 +1,22 @@
+#ifndef AUXILIARY_FILE_H
+#define AUXILIARY_FILE_H
+
+#include<stddef.h>
+
+#include"shared_resources.h"
+#include"set_generator.h"
+
+typedef struct{
+    size_t start; // Offset of the first character of the simulation set (or generator expression).
+    size_t end; // Offset just after the period that ends the simulation set (or the end of the file).
+    int first_set; // Index of the first simulation set of the entry.
+    int num_sets; // 1 for a simulation set or the number of sets produced by a generator.
+    Set_Generator generator; // NULL for a simulation set written explicitly.
+} Simulation_Set_Entry;
+
+Function_Status open_auxiliary_file();
+int get_simulation_set_quantity();
+Function_Status load_simulation_set(int set_index);
+void close_auxiliary_file();
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef BATCH_ENGINE_H
+#define BATCH_ENGINE_H
+
+#include"watchdog.h"
+#include"shared_resources.h"
+
+typedef struct{
+    int number_timesteps;
+    double delta; // Calculated only for the output format 4.
+    enum Censoring_Reason censoring; // Reason why the simulation was stopped before the environment was empty, if it was.
+} Simulation_Result;
+
+Function_Status run_simulation_batch(int num_simulations, Simulation_Result *results);
+void deallocate_batch_engine();
+
+#endif
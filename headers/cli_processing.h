@@ -11,7 +11,14 @@ typedef struct{
     char environment_filename[150];
     char output_filename[150];
     char auxiliary_filename[150];
+    char live_stream_name[150];
+    char converted_environment_filename[150]; // When provided, the environment is only converted to the binary format.
+    char exit_sets[150]; // Simulation sets given in the command line, with the auxiliary file syntax.
+    char spawn_zones[150]; // Rectangles where the random pedestrians are placed; empty for the whole environment.
     enum Output_Format output_format;
+    enum Heatmap_Encoding heatmap_encoding;
+    enum Grid_Layout grid_layout; // Layout of the grids of the static weight calculation.
+    enum Compression_Method compression_method;
     enum Environment_Origin environment_origin;
     bool write_to_file;
     bool show_debug_information;
@@ -21,13 +28,29 @@ typedef struct{
     bool prevent_corner_crossing;
     bool allow_X_movement;
     bool single_exit_flag;
+    bool common_random_numbers;
+    bool async_output;
+    bool static_field_cache;
+    bool parallel_timestep;
     int global_line_number;
     int global_column_number;
     int num_simulations;
+    int max_simulations;
+    int simulation_batch;
     int total_num_pedestrians;
     int seed;
+    int compression_level; // 0 selects the default level of the compression method.
+    int first_set; // First simulation set of the auxiliary file to be simulated, starting at 1.
+    int last_set; // Last simulation set to be simulated; 0 selects the last set of the auxiliary file.
+    int num_threads; // Number of threads of the parallel computations; 0 selects the number of processors.
+    int parallel_field_cells; // Minimum number of cells for the static weights to be calculated in parallel.
+    int parallel_exit_cells; // Minimum number of cells for the grids of each exit to be calculated concurrently.
+    int batch_seeds; // Number of simulations advanced together.
+    int max_timesteps; // Maximum number of timesteps of a simulation; 0 disables the maximum.
+    int stall_timesteps; // Timesteps without progress after which a simulation is stopped; 0 disables the detection.
     double alpha;
     double diagonal;
+    double ci_tolerance;
 } Command_Line_Args;
 
 error_t parser_function(int key, char *arg, struct argp_state *state);
@@ -0,0 +1,15 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include<stdio.h>
+
+#include"shared_resources.h"
+
+#define GZIP_DEFAULT_LEVEL 6
+#define ZSTD_DEFAULT_LEVEL 3
+#define COMPRESSED_CHUNK_SIZE (1 << 18) // Size of the buffer that receives the compressed data before it is written, in bytes.
+
+FILE *open_compressed_stream(FILE *destination);
+const char *get_compression_extension();
+
+#endif
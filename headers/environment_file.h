@@ -0,0 +1,29 @@
+#ifndef ENVIRONMENT_FILE_H
+#define ENVIRONMENT_FILE_H
+
+#include"shared_resources.h"
+
+/*
+    Binary environment format (all integers are unsigned LEB128 varints, except the magic):
+
+    Header:         "ALZE" | version | lines | columns
+    Structure:      number of runs | length of each run
+    Exits:          number of exit cells | cell index gap of each exit cell
+    Pedestrians:    number of pedestrians | cell index gap of each pedestrian
+
+    The cells are numbered line by line (line * columns + column). The runs alternate between empty cells and walls, starting
+    with empty cells (the first run is empty when the environment starts with a wall), and cover every cell. Exit cells are walls.
+    Exits and pedestrians are ordered by cell index, and the gap is the difference to the index of the previous one (or to 0, for
+    the first one), so they are loaded in the same order as from the text format.
+*/
+
+#define ENVIRONMENT_MAGIC "ALZE"
+#define ENVIRONMENT_VERSION 1
+
+typedef Function_Status (*Dimensions_Handler)(int lines, int columns);
+typedef Function_Status (*Symbol_Handler)(char read_char, Location coordinates);
+
+Function_Status read_environment_file(const char *filename, Dimensions_Handler dimensions_handler, Symbol_Handler symbol_handler);
+Function_Status convert_environment_file(const char *filename, const char *converted_filename);
+
+#endif
@@ -10,13 +10,22 @@ struct exit {
     Double_Grid static_weight;
     Double_Grid dynamic_weight;
     Double_Grid floor_field;
+    // With --grid-layout=sparse, the grids above are NULL and the grids of the exit are kept in tiles, materialized only where the exit is reachable.
+    Sparse_Grid *sparse_static_weight;
+    Sparse_Grid *sparse_dynamic_weight;
+    Sparse_Grid *sparse_floor_field;
 };
 typedef struct exit * Exit;
 
+// Reads a cell of one of the grids of an exit (static_weight, dynamic_weight or floor_field), whether it is dense or sparse.
+#define EXIT_GRID_CELL(exit, grid, line, column) \
+    ((exit)->grid != NULL ? (exit)->grid[line][column] : get_sparse_cell((exit)->sparse_##grid, line, column))
+
 typedef struct{
     Double_Grid final_floor_field; // Floor field obtained by combining the floor fields of each door
     Exit *list;
     int num_exits;
+    unsigned int final_floor_field_version; // Incremented whenever the final floor field is allocated or calculated.
 } Exits_Set;
 
 Function_Status add_new_exit(Location exit_coordinates);
@@ -26,6 +35,7 @@ Function_Status calculate_all_static_weights();
 Function_Status calculate_all_dynamic_weights();
 Function_Status calculate_all_exits_floor_field();
 Function_Status calculate_final_floor_field();
+double calculate_distribution_delta();
 void deallocate_exits();
 
 extern Exits_Set exits_set;
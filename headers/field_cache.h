@@ -0,0 +1,12 @@
+#ifndef FIELD_CACHE_H
+#define FIELD_CACHE_H
+
+#include"shared_resources.h"
+#include"exit.h"
+
+#define FIELD_BATCH_SIZE 8 // Number of exit cells whose static weights are calculated at once (lanes of a vector of doubles).
+
+Function_Status load_cached_static_weight(Exit current_exit);
+void deallocate_field_cache();
+
+#endif
@@ -5,11 +5,47 @@
 
 #include"shared_resources.h"
 
+#define TILE_SHIFT 3
+#define TILE_SIDE (1 << TILE_SHIFT) // Lines and columns of each tile of a Tiled_Grid.
+
 typedef int ** Int_Grid;
 typedef double ** Double_Grid;
 
+typedef struct{
+    double *cells; // Tiles in row-major order, each with its TILE_SIDE x TILE_SIDE cells in row-major order.
+    int tile_columns; // Number of tiles in each line of tiles.
+} Tiled_Grid;
+
+/**
+ * Finds the position of a cell in the cells of a Tiled_Grid. The cells of a tile are contiguous, so the 3x3 neighborhoods
+ * mostly fall in the same few cache lines, and a sweep over the tiles in order reads the cells sequentially.
+ *
+ * @param grid The Tiled_Grid.
+ * @param line Line of the cell (non-negative).
+ * @param column Column of the cell (non-negative).
+ * @return The index of the cell.
+*/
+static inline long long tiled_cell_index(Tiled_Grid grid, int line, int column)
+{
+    long long tile_index = (long long) (line >> TILE_SHIFT) * grid.tile_columns + (column >> TILE_SHIFT);
+    return (tile_index << (2 * TILE_SHIFT)) + ((line & (TILE_SIDE - 1)) << TILE_SHIFT) + (column & (TILE_SIDE - 1));
+}
+
+#define TILED_CELL(grid, line, column) (grid).cells[tiled_cell_index(grid, line, column)]
+
+typedef struct{
+    double **tiles; // TILE_SIDE x TILE_SIDE tiles in row-major order, NULL for the tiles that weren't materialized.
+    int tile_columns; // Number of tiles in each line of tiles.
+    int num_tiles;
+    double wall_value; // Value of the walls and obstacles of the tiles that weren't materialized.
+    double background_value; // Value of the other cells of those tiles.
+} Sparse_Grid;
+
 Int_Grid allocate_integer_grid(int line_number, int column_number);
 Double_Grid allocate_double_grid(int line_number, int column_number);
+Tiled_Grid allocate_tiled_grid(int line_number, int column_number);
+Sparse_Grid *allocate_sparse_grid(int line_number, int column_number);
+double *materialize_sparse_tile(Sparse_Grid *grid, int tile_index);
 Function_Status reset_integer_grid(Int_Grid integer_grid, int line_number, int column_number);
 Function_Status reset_double_grid(Double_Grid double_grid, int line_number, int column_number);
 Function_Status copy_double_grid(Double_Grid destination, Double_Grid source);
@@ -17,9 +53,28 @@ bool is_diagonal_valid(Location origin_cell, Location target_cell, Double_Grid f
 bool is_within_grid_lines(int line_coordinate);
 bool is_within_grid_columns(int column_coordinate);
 void deallocate_grid(void **grid, int line_number);
+void deallocate_tiled_grid(Tiled_Grid *grid);
+void deallocate_sparse_grid(Sparse_Grid *grid);
 
 extern Int_Grid environment_only_grid;
 extern Int_Grid pedestrian_position_grid;
 extern Int_Grid heatmap_grid;
 
+/**
+ * Reads a cell of a Sparse_Grid. The cells of the tiles that weren't materialized take the wall value, if they are walls or obstacles in the environment_only_grid, or the background value otherwise.
+ *
+ * @param grid The Sparse_Grid.
+ * @param line Line of the cell.
+ * @param column Column of the cell.
+ * @return The value of the cell.
+*/
+static inline double get_sparse_cell(const Sparse_Grid *grid, int line, int column)
+{
+    const double *tile = grid->tiles[(line >> TILE_SHIFT) * grid->tile_columns + (column >> TILE_SHIFT)];
+    if(tile != NULL)
+        return tile[((line & (TILE_SIDE - 1)) << TILE_SHIFT) + (column & (TILE_SIDE - 1))];
+
+    return environment_only_grid[line][column] == WALL_VALUE ? grid->wall_value : grid->background_value;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef HEATMAP_H
+#define HEATMAP_H
+
+#include<stdio.h>
+
+#include"shared_resources.h"
+
+/*
+    Binary heatmap format (all integers are unsigned LEB128 varints, except the magic and the record tags):
+
+    Header:     "ALZH" | version | lines | columns
+    Records:    HEATMAP_SET      | number of simulations | number of runs | (line, first column, length, length visit counts) of each run
+                HEATMAP_CENSORED | number of censored simulations
+
+    A run is a maximal sequence of cells with nonzero visit counts in a single line. Runs are ordered by line and column.
+    Simulation sets with inaccessible exits have zero simulations and zero runs.
+    A HEATMAP_CENSORED record precedes the HEATMAP_SET record of a simulation set with simulations stopped (--max-timesteps or
+    --stall-timesteps) before the environment was empty, whose visits are counted up to the stop. Version 1 files have no censored records.
+*/
+
+#define HEATMAP_MAGIC "ALZH"
+#define HEATMAP_VERSION 2
+#define HEATMAP_SET 'H'
+#define HEATMAP_CENSORED 'C'
+
+#define HEATMAP_WORKERS 1 // Number of heatmap accumulators of the sequential timestep, which runs on a single worker.
+
+Function_Status allocate_heatmap_accumulators(int num_workers);
+void set_heatmap_worker(int worker_index);
+void record_heatmap_visit(Location cell);
+void reduce_heatmap_accumulators();
+void write_binary_heatmap_header(FILE *output_stream);
+void write_binary_heatmap(FILE *output_stream, int num_simulations);
+void write_binary_heatmap_censored(FILE *output_stream, int num_censored_simulations);
+void deallocate_heatmap_accumulators();
+
+#endif
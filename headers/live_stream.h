@@ -0,0 +1,65 @@
+#ifndef LIVE_STREAM_H
+#define LIVE_STREAM_H
+
+#include<stdint.h>
+#include<stdatomic.h>
+
+#include"shared_resources.h"
+
+/*
+    Layout of the shared memory object: a Live_Stream_Header, padded to LIVE_STREAM_HEADER_SIZE bytes, followed by LIVE_STREAM_SLOTS slots of live_stream_slot_size() bytes.
+    Each slot holds a Live_Frame_Header followed by lines * columns cell kinds, in row-major order.
+
+    Frames are numbered from 1. Frame n is written to slot (n - 1) % LIVE_STREAM_SLOTS, whose sequence is 2n - 1 while it is being
+    written and 2n once complete, after which latest_frame becomes n. Readers copy the slot and check that its sequence was 2n both
+    before and after the copy (otherwise the writer has reused the slot and the frame is skipped), so the writer never waits for them.
+*/
+
+#define LIVE_STREAM_MAGIC "ALZL"
+#define LIVE_STREAM_VERSION 1
+#define LIVE_STREAM_SLOTS 16
+#define LIVE_STREAM_HEADER_SIZE 64 // Space reserved for the Live_Stream_Header before the first slot.
+#define LIVE_STREAM_DEFAULT_NAME "/alizadeh_live"
+
+#define LIVE_EMPTY_CELL 0
+#define LIVE_WALL_CELL 1
+#define LIVE_EXIT_CELL 2
+#define LIVE_PEDESTRIAN_CELL 3
+
+typedef struct{
+    char magic[4];
+    uint32_t version;
+    uint32_t line_number;
+    uint32_t column_number;
+    uint32_t num_slots;
+    _Atomic uint32_t finished; // Set when the simulation program ends.
+    _Atomic uint64_t latest_frame; // Number of the last complete frame (0 when none was published).
+} Live_Stream_Header;
+
+typedef struct{
+    _Atomic uint64_t sequence;
+    uint32_t set_index;
+    uint32_t simulation_index;
+    uint32_t timestep;
+    uint32_t num_pedestrians; // Pedestrians still in the environment.
+} Live_Frame_Header;
+
+/**
+ * Size in bytes of each slot of the ring buffer, rounded up to a multiple of 64 so that slots don't share cache lines.
+ *
+ * @param line_number Number of lines of the environment.
+ * @param column_number Number of columns of the environment.
+ * @return The size of a slot.
+*/
+static inline size_t live_stream_slot_size(int line_number, int column_number)
+{
+    size_t slot_size = sizeof(Live_Frame_Header) + (size_t) line_number * column_number;
+    return (slot_size + 63) & ~(size_t) 63;
+}
+
+Function_Status open_live_stream();
+void begin_live_stream_set();
+void publish_live_frame(int simulation_index, int timestep);
+void close_live_stream();
+
+#endif
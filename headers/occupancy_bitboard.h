@@ -0,0 +1,88 @@
+#ifndef OCCUPANCY_BITBOARD_H
+#define OCCUPANCY_BITBOARD_H
+
+#include<stddef.h>
+#include<stdint.h>
+#include<stdbool.h>
+
+#include"shared_resources.h"
+
+/*
+    A bitboard keeps one bit per cell, in lines of bitboard_words_per_line 64-bit words. The environment is surrounded by a ring of
+    cells, so the cell (line, column) is the bit column + 1 of the line line + 1, and each line has at least one extra word, so that
+    three adjacent bits can always be read from two consecutive words.
+
+    The 8 neighbors of a cell are given by a Neighbor_Mask, with the bit n for the neighbor n of neighbor_offsets, which follows the
+    order scanned by find_smallest_cell, so the set bits, from the lowest, give the neighbors in the order of the original scan.
+*/
+
+typedef uint8_t Neighbor_Mask;
+
+Function_Status prepare_neighbor_bitboards();
+void deallocate_neighbor_bitboards();
+
+extern const Location neighbor_offsets[8];
+extern uint64_t *occupancy_bitboard; // Cells occupied by a pedestrian.
+extern uint64_t *wall_bitboard; // Walls of the final floor field and the ring around the environment.
+extern int bitboard_words_per_line;
+extern Neighbor_Mask admissible_neighbors[2][256]; // Neighbors that can be reached, indexed by prevent_corner_crossing and by the mask of neighboring walls.
+
+/**
+ * Reads the bits of the given cell and of its left and right neighbors.
+ *
+ * @param bitboard Bitboard to be read.
+ * @param line Line of the cell (from -1 to the number of lines).
+ * @param column Column of the cell (from 0 to the number of columns - 1).
+ * @return The three bits, with the left neighbor in the lowest bit.
+*/
+static inline unsigned int extract_bitboard_triple(const uint64_t *bitboard, int line, int column)
+{
+    const uint64_t *bitboard_line = bitboard + (size_t) (line + 1) * bitboard_words_per_line;
+    int word = column >> 6, offset = column & 63; // The left neighbor is the bit column of the line.
+
+    // The second shift is split in two, since a shift of 64 bits is undefined.
+    return ((bitboard_line[word] >> offset) | (bitboard_line[word + 1] << 1 << (63 - offset))) & 7;
+}
+
+/**
+ * Builds the Neighbor_Mask of the given cell with the bits of a bitboard.
+ *
+ * @param bitboard Bitboard to be read.
+ * @param cell Cell inside the environment.
+ * @return The Neighbor_Mask.
+*/
+static inline Neighbor_Mask get_neighbor_mask(const uint64_t *bitboard, Location cell)
+{
+    unsigned int upper = extract_bitboard_triple(bitboard, cell.lin - 1, cell.col);
+    unsigned int middle = extract_bitboard_triple(bitboard, cell.lin, cell.col);
+    unsigned int lower = extract_bitboard_triple(bitboard, cell.lin + 1, cell.col);
+
+    return upper | (middle & 1) << 3 | (middle & 4) << 2 | lower << 5;
+}
+
+/**
+ * Finds the neighbors of the given cell that can be reached from it, with the same rules as find_smallest_cell and is_diagonal_valid.
+ *
+ * @param cell Cell inside the environment.
+ * @param prevent_corner_crossing Indicates that diagonals through the corners of obstacles are blocked.
+ * @return The Neighbor_Mask of the reachable neighbors.
+*/
+static inline Neighbor_Mask get_admissible_neighbors(Location cell, bool prevent_corner_crossing)
+{
+    return admissible_neighbors[prevent_corner_crossing][get_neighbor_mask(wall_bitboard, cell)];
+}
+
+/**
+ * Verifies if the bit of the given cell is set.
+ *
+ * @param bitboard Bitboard to be read.
+ * @param cell Cell inside the environment.
+ * @return bool, where True indicates that the bit is set.
+*/
+static inline bool is_bitboard_cell_set(const uint64_t *bitboard, Location cell)
+{
+    const uint64_t *bitboard_line = bitboard + (size_t) (cell.lin + 1) * bitboard_words_per_line;
+    return (bitboard_line[(cell.col + 1) >> 6] >> ((cell.col + 1) & 63)) & 1;
+}
+
+#endif
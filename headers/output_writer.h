@@ -0,0 +1,17 @@
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+#include<stdio.h>
+
+#include"shared_resources.h"
+
+#define OUTPUT_BUFFER_SIZE (1 << 20) // Size of the stdio buffer of the output stream (and of each asynchronous buffer), in bytes.
+#define ASYNC_OUTPUT_BUFFERS 4 // Number of buffers shared by the simulation and the writer thread.
+
+Function_Status configure_output_buffer(FILE **output_stream);
+void flush_output_stream(FILE *output_stream);
+void write_text(FILE *output_stream, const char *text);
+void write_integer(FILE *output_stream, int value, char terminator);
+void write_fixed(FILE *output_stream, double value, int precision, char terminator);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef PARALLEL_FIELD_H
+#define PARALLEL_FIELD_H
+
+#include"shared_resources.h"
+#include"exit.h"
+
+#define DEFAULT_PARALLEL_FIELD_CELLS 1000000 // Environments with at least this number of cells have the static weights calculated in parallel.
+
+Function_Status calculate_parallel_static_weight(Exit current_exit);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef PARALLEL_TIMESTEP_H
+#define PARALLEL_TIMESTEP_H
+
+#include"shared_resources.h"
+
+int get_timestep_band_quantity();
+Function_Status run_parallel_timestep();
+void deallocate_parallel_timestep();
+
+#endif
@@ -2,7 +2,15 @@
 #define PEDESTRIAN_H
 
 #include"shared_resources.h"
+#include"random_stream.h"
 
+#define PANIC_PROBABILITY 0.05
+
+typedef struct cell_conflict{
+    int num_pedestrians;
+    int pedestrian_ids[8];
+    int pedestrian_allowed;
+}cell_conflict;
 typedef struct cell_conflict * Cell_Conflict;
 
 enum Pedestrian_State {LEAVING, GOT_OUT, STOPPED, MOVING};
@@ -10,6 +18,8 @@ enum Pedestrian_State {LEAVING, GOT_OUT, STOPPED, MOVING};
 struct pedestrian {
     int id;
     bool in_panic;
+    int timesteps_to_panic; // Timesteps up to the next panic, drawn from a geometric distribution (0 if not drawn yet).
+    double best_floor_field_value; // Smallest floor field value reached by the pedestrian (-DBL_MAX once out of the environment), read by the watchdog.
     enum Pedestrian_State state;
     Location origin; // Original pedestrian localization. Remains unchanged until the structure instance is deallocated.
     Location current; 
@@ -26,18 +36,38 @@ Function_Status insert_pedestrians_at_random(int qtd);
 Function_Status add_new_pedestrian(Location pedestrian_coordinates);
 void deallocate_pedestrians();
 int determine_pedestrians_in_panic();
+bool determine_pedestrian_panic(Pedestrian current_pedestrian);
 void evaluate_pedestrians_movements();
+void evaluate_pedestrian_movement(Pedestrian current_pedestrian);
 Function_Status identify_pedestrian_conflicts(Cell_Conflict *pedestrian_conflicts, int *num_conflicts);
 Function_Status solve_pedestrian_conflicts(Cell_Conflict pedestrian_conflicts, int num_conflicts);
 void print_pedestrian_conflict_information(Cell_Conflict pedestrian_conflicts, int num_conflicts);
 void block_X_movement();
+bool are_pedestrian_paths_crossing(Pedestrian first_pedestrian, Pedestrian second_pedestrian);
+void solve_X_movement(Pedestrian first_pedestrian, Pedestrian second_pedestrian);
 void apply_pedestrian_movement();
+void move_pedestrian(Pedestrian current_pedestrian);
 void update_pedestrian_position_grid();
 bool is_environment_empty();
 void reset_pedestrian_state();
 void reset_pedestrian_panic();
 void reset_pedestrians_structures();
+Function_Status run_pedestrian_timestep();
 
 extern Pedestrian_Set pedestrian_set;
 
+/**
+ * Determines if the given pedestrian panics in the current timestep, which happens with a probability defined by PANIC_PROBABILITY. The number of timesteps up to the next panic follows a geometric distribution, so a single random number is drawn for each panic, instead of one for each timestep.
+ *
+ * @param current_pedestrian A pedestrian still in the environment.
+ * @return bool, where True indicates that the pedestrian panics.
+*/
+static inline bool draw_pedestrian_panic(Pedestrian current_pedestrian)
+{
+    if(current_pedestrian->timesteps_to_panic == 0)
+        current_pedestrian->timesteps_to_panic = draw_random_geometric(current_pedestrian->id, PANIC_STREAM, PANIC_PROBABILITY);
+
+    return --current_pedestrian->timesteps_to_panic == 0;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include"shared_resources.h"
+
+#define MAX_SPAWN_ZONES 32
+
+Function_Status draw_placement_cells(int num_cells, Location *drawn_cells);
+void deallocate_placement_cells();
+
+#endif
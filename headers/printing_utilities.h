@@ -2,9 +2,13 @@
 #define PRINTING_UTILITIES_H
 
 #include"grid.h"
+#include"statistics.h"
 
 void print_full_command(FILE *output_stream);
 void print_heatmap(FILE *output_stream);
+void print_sparse_heatmap(FILE *output_stream);
+void print_evacuation_statistics(FILE *output_stream, Streaming_Statistics *statistics);
+void print_paired_difference(FILE *output_stream, int *reference_timesteps, int *current_timesteps, int num_pairs);
 void print_pedestrian_position_grid(FILE *output_stream, int simulation_number, int timestep);
 void print_int_grid(Int_Grid int_grid);
 void print_double_grid(Double_Grid double_grid);
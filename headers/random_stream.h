@@ -0,0 +1,30 @@
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include<stdint.h>
+
+#include"shared_resources.h"
+
+enum Random_Stream {
+    PLACEMENT_STREAM = 0,
+    PANIC_STREAM,
+    TIE_BREAK_STREAM,
+    CONFLICT_STREAM,
+    X_MOVEMENT_STREAM,
+    NUM_RANDOM_STREAMS
+};
+
+typedef struct{
+    uint64_t seed;
+    unsigned int *counters;
+    int capacity;
+} Random_Stream_State; // Substreams of a simulation that isn't currently running (see swap_random_stream_state).
+
+void reset_random_streams(int seed);
+Function_Status reserve_random_streams(int max_pedestrian_id);
+int draw_random_integer(int pedestrian_id, enum Random_Stream stream, int upper_bound);
+int draw_random_geometric(int pedestrian_id, enum Random_Stream stream, double probability);
+void swap_random_stream_state(Random_Stream_State *state);
+void deallocate_random_streams();
+
+#endif
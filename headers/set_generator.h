@@ -0,0 +1,56 @@
+#ifndef SET_GENERATOR_H
+#define SET_GENERATOR_H
+
+#include<stddef.h>
+#include<stdbool.h>
+
+#include"shared_resources.h"
+
+/*
+    Generator expression (a simulation set of the auxiliary syntax that starts with @):
+
+        @doors COUNT[-COUNT] WIDTH[-WIDTH] [border|top|bottom|left|right] [unique].
+
+    Generates every combination of COUNT doors, each one with WIDTH contiguous cells along the chosen side of the
+    environment border (default is the whole border). Combinations differ only in the set of doors, never in their order.
+*/
+
+#define GENERATOR_SYMMETRIES 3 // Mirrored columns, mirrored lines and both (180 degrees rotation).
+
+enum Border_Side{
+    TOP_SIDE,
+    BOTTOM_SIDE,
+    LEFT_SIDE,
+    RIGHT_SIDE,
+    WHOLE_BORDER
+};
+
+typedef struct{
+    enum Border_Side side;
+    int offset; // Position of the first cell of the door along the side.
+    int width;
+} Door_Placement;
+
+struct set_generator{
+    int min_doors;
+    int max_doors;
+    int min_width;
+    int max_width;
+    enum Border_Side side;
+    bool unique; // Skips combinations that are mirror images of a previous combination, under the symmetries of the environment.
+    Door_Placement *placements; // Every valid (accessible) door, ordered by width, side and offset.
+    int num_placements;
+    int *mirrors[GENERATOR_SYMMETRIES]; // Index of the mirrored placement for each symmetry of the environment (NULL when the environment isn't symmetric).
+    int num_sets;
+    int current_set; // Index of the combination stored in combination (-1 before the first one).
+    int current_doors;
+    int *combination; // Increasing indices of the placements of the current combination.
+};
+typedef struct set_generator * Set_Generator;
+
+Set_Generator create_set_generator(const char *expression, size_t length);
+int get_generated_set_quantity(Set_Generator generator);
+Function_Status load_generated_set(Set_Generator generator, int set_index);
+void deallocate_set_generator(Set_Generator generator);
+
+#endif
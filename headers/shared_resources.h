@@ -7,7 +7,28 @@ enum Output_Format {
     OUTPUT_VISUALIZATION = 1, 
     OUTPUT_TIMESTEPS_COUNT, 
     OUTPUT_HEATMAP,
-    OUTPUT_DISTRIBUTION_VARIATION
+    OUTPUT_DISTRIBUTION_VARIATION,
+    OUTPUT_TIMESTEPS_STATISTICS,
+    OUTPUT_PAIRED_DIFFERENCE,
+    OUTPUT_TRAJECTORY
+};
+
+enum Heatmap_Encoding {
+    HEATMAP_DENSE = 1,
+    HEATMAP_SPARSE,
+    HEATMAP_BINARY
+};
+
+enum Grid_Layout {
+    ROW_MAJOR_LAYOUT = 1,
+    TILED_LAYOUT,
+    SPARSE_LAYOUT
+};
+
+enum Compression_Method {
+    NO_COMPRESSION,
+    GZIP_COMPRESSION,
+    ZSTD_COMPRESSION
 };
 
 enum Environment_Origin {
@@ -36,5 +57,6 @@ typedef struct{
 bool origin_uses_auxiliary_data();
 bool origin_uses_static_pedestrians();
 bool origin_uses_static_exits();
+bool is_output_binary();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,12 @@
+#ifndef SMALL_TIMESTEP_H
+#define SMALL_TIMESTEP_H
+
+#include"shared_resources.h"
+#include"timestep_variants.h"
+
+#define SMALL_GRID_SIZE 64 // Environments with at most this number of lines and columns use the small environment timestep.
+
+bool is_small_environment();
+Timestep_Function get_small_timestep_variant(int variant_index);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include"shared_resources.h"
+
+#define HISTOGRAM_BINS 256
+
+typedef struct{
+    int count;
+    double mean;
+    double sum_squared_deviations; // Sum of the squared deviations from the mean (M2 in Welford's algorithm).
+    int minimum;
+    int maximum;
+    int bin_width; // Number of consecutive values aggregated in a single histogram bin.
+    int histogram[HISTOGRAM_BINS];
+} Streaming_Statistics;
+
+void reset_streaming_statistics(Streaming_Statistics *statistics);
+void add_streaming_statistics_value(Streaming_Statistics *statistics, int value);
+double calculate_streaming_variance(Streaming_Statistics *statistics);
+double calculate_streaming_quantile(Streaming_Statistics *statistics, double quantile);
+double calculate_confidence_half_width(int count, double variance);
+
+#endif
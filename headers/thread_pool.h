@@ -0,0 +1,13 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include"shared_resources.h"
+
+#define DEFAULT_PARALLEL_EXIT_CELLS 10000 // Environments with at least this number of cells have the grids of each exit calculated concurrently.
+
+typedef Function_Status (*Pool_Task)(int task_index);
+
+void run_pool_tasks(Pool_Task task, int num_tasks, Function_Status *task_statuses);
+void deallocate_thread_pool();
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef TILED_FIELD_H
+#define TILED_FIELD_H
+
+#include"shared_resources.h"
+#include"exit.h"
+
+Function_Status calculate_tiled_static_weight(Exit current_exit);
+
+#endif
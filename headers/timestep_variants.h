@@ -0,0 +1,23 @@
+#ifndef TIMESTEP_VARIANTS_H
+#define TIMESTEP_VARIANTS_H
+
+#include"shared_resources.h"
+
+// Applies the macro to every combination of the toggle options of the timestep variants (--always-to-lowest inverted, --avoid-corner-movement,
+// --immediate-exit, --allow-x-movement and the heatmap output), each given as 0 or 1, with the first option as the most significant bit.
+#define FOR_EACH_HEATMAP_OPTION(macro, u, c, i, x) macro(u, c, i, x, 0) macro(u, c, i, x, 1)
+#define FOR_EACH_X_OPTION(macro, u, c, i) FOR_EACH_HEATMAP_OPTION(macro, u, c, i, 0) FOR_EACH_HEATMAP_OPTION(macro, u, c, i, 1)
+#define FOR_EACH_EXIT_OPTION(macro, u, c) FOR_EACH_X_OPTION(macro, u, c, 0) FOR_EACH_X_OPTION(macro, u, c, 1)
+#define FOR_EACH_CORNER_OPTION(macro, u) FOR_EACH_EXIT_OPTION(macro, u, 0) FOR_EACH_EXIT_OPTION(macro, u, 1)
+#define FOR_EACH_TIMESTEP_VARIANT(macro) FOR_EACH_CORNER_OPTION(macro, 0) FOR_EACH_CORNER_OPTION(macro, 1)
+
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
+typedef Function_Status (*Timestep_Function)();
+
+void select_timestep_variant();
+void block_bitboard_X_movement();
+
+extern Timestep_Function run_timestep;
+
+#endif
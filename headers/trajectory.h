@@ -0,0 +1,48 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include<stdio.h>
+
+#include"shared_resources.h"
+
+/*
+    Binary trajectory format (all integers are unsigned LEB128 varints, except the magic and the record tags):
+
+    Header:     "ALZT" | version | length of the full command | full command | lines | columns | lines * columns cell kinds
+    Records:    TRAJECTORY_SET          | number of exit cells | (line, column) of each exit cell
+                TRAJECTORY_SIMULATION   | simulation index | number of pedestrians | (line, column) of each pedestrian
+                TRAJECTORY_TIMESTEP     | number of events | (id gap, event code) of each event
+                TRAJECTORY_END          | number of timesteps
+                TRAJECTORY_CENSORED_END | number of timesteps
+
+    A simulation ends with TRAJECTORY_CENSORED_END instead of TRAJECTORY_END when it was stopped (--max-timesteps or --stall-timesteps)
+    before the environment was empty. Version 1 files have no censored records.
+
+    The events of a timestep are ordered by pedestrian id, and the id gap is the difference to the id of the previous event (or to 0,
+    for the first event). The event code is the direction of the movement, (line delta + 1) * 3 + (column delta + 1), or
+    TRAJECTORY_EXIT_EVENT, when the pedestrian is removed from the environment.
+*/
+
+#define TRAJECTORY_MAGIC "ALZT"
+#define TRAJECTORY_VERSION 2
+
+#define TRAJECTORY_EMPTY_CELL 0
+#define TRAJECTORY_WALL_CELL 1
+
+#define TRAJECTORY_SET 'S'
+#define TRAJECTORY_SIMULATION 'B'
+#define TRAJECTORY_TIMESTEP 'T'
+#define TRAJECTORY_END 'E'
+#define TRAJECTORY_CENSORED_END 'C'
+
+#define TRAJECTORY_EXIT_EVENT 9
+
+Function_Status write_trajectory_header(FILE *output_stream);
+void write_trajectory_set(FILE *output_stream);
+Function_Status write_trajectory_simulation_start(FILE *output_stream, int simulation_index);
+void write_trajectory_timestep(FILE *output_stream);
+void write_trajectory_simulation_end(FILE *output_stream, int number_timesteps, bool is_censored);
+void write_varint(FILE *output_stream, unsigned int value);
+void deallocate_trajectory();
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include"shared_resources.h"
+
+enum Censoring_Reason {NOT_CENSORED, TIMESTEP_CAP_REACHED, SIMULATION_STALLED};
+
+bool is_watchdog_enabled();
+enum Censoring_Reason check_simulation_progress(int number_timesteps, int *timesteps_without_progress);
+const char *get_censoring_description(enum Censoring_Reason censoring);
+
+#endif
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+gcc -o build/replay.exe tools/replay.c -g && ./build/replay.exe "$@"
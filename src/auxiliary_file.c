@@ -0,0 +1,344 @@
+/*
+   File: auxiliary_file.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module reads the auxiliary file, which holds the exits of each simulation set. The file is memory-mapped and indexed in a single pass, storing the offsets of every simulation set, so any set can be loaded by its index (allowing a range of sets to be simulated, as with the --sets option). The exit coordinates are extracted with a hand-written scanner, and the generator expressions are expanded by the set_generator module. The same syntax can also be given directly in the command line, with the --exit-sets option.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<ctype.h>
+#include<string.h>
+#include<limits.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+#include"../headers/exit.h"
+#include"../headers/set_generator.h"
+#include"../headers/auxiliary_file.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+const char *auxiliary_path = "auxiliary/";
+
+static const char *auxiliary_data = NULL; // Mapped content of the auxiliary file (or the --exit-sets argument).
+static size_t auxiliary_size = 0;
+static bool auxiliary_mapped = false;
+static Simulation_Set_Entry *simulation_set_entries = NULL;
+static int num_entries = 0;
+static int simulation_set_quantity = 0; // Total number of simulation sets, including the generated ones.
+
+static Function_Status index_simulation_sets();
+static size_t skip_whitespace(size_t position, size_t end);
+static bool scan_integer(size_t *position, size_t end, int *value);
+static int find_entry(int set_index);
+
+/**
+ * Maps the auxiliary file in memory (or takes the argument of --exit-sets) and builds the index of its simulation sets.
+ *
+ * @note The environment must be loaded beforehand, as generators depend on it.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status open_auxiliary_file()
+{
+    char complete_path[500] = "";
+
+    if( origin_uses_auxiliary_data() == false)
+        return SUCCESS;
+
+    if(strcmp(cli_args.exit_sets, "") != 0)
+    {
+        auxiliary_data = cli_args.exit_sets;
+        auxiliary_size = strlen(cli_args.exit_sets);
+
+        return index_simulation_sets();
+    }
+
+    sprintf(complete_path,"%s%s",auxiliary_path,cli_args.auxiliary_filename);
+
+    int file_descriptor = open(complete_path, O_RDONLY);
+    if(file_descriptor == -1)
+    {
+        fprintf(stderr, "It was not possible to open the auxiliary file.\n");
+        return FAILURE;
+    }
+
+    struct stat file_information;
+    if(fstat(file_descriptor, &file_information) == -1)
+    {
+        fprintf(stderr, "It was not possible to obtain the size of the auxiliary file.\n");
+        close(file_descriptor);
+        return FAILURE;
+    }
+
+    auxiliary_size = file_information.st_size;
+    if(auxiliary_size > 0) // An empty file can't be mapped, but it is valid (no simulation sets).
+    {
+        void *mapping = mmap(NULL, auxiliary_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if(mapping == MAP_FAILED)
+        {
+            fprintf(stderr, "It was not possible to map the auxiliary file in memory.\n");
+            close(file_descriptor);
+            return FAILURE;
+        }
+
+        madvise(mapping, auxiliary_size, MADV_SEQUENTIAL); // The index is built with a single sequential pass.
+        auxiliary_data = mapping;
+        auxiliary_mapped = true;
+    }
+
+    close(file_descriptor); // The mapping remains valid after the descriptor is closed.
+
+    return index_simulation_sets();
+}
+
+/**
+ * Returns the number of simulation sets in the auxiliary file, including the sets produced by generators.
+ *
+ * @return A non-negative integer.
+*/
+int get_simulation_set_quantity()
+{
+    return simulation_set_quantity;
+}
+
+/**
+ * Extracts the exits coordinates of the simulation set with the given index, adding them to the environment.
+ *
+ * @param set_index Index of the simulation set (starting at 0), in the order in which the sets appear in the auxiliary file.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_simulation_set(int set_index)
+{
+    if(set_index < 0 || set_index >= simulation_set_quantity)
+    {
+        fprintf(stderr, "The simulation set %d doesn't exist in the auxiliary file.\n", set_index + 1);
+        return FAILURE;
+    }
+
+    Simulation_Set_Entry *entry = &simulation_set_entries[find_entry(set_index)];
+    if(entry->generator != NULL)
+        return load_generated_set(entry->generator, set_index - entry->first_set);
+
+    size_t position = entry->start;
+    size_t end = entry->end;
+    bool new_exit = true; // True for a new exit, False for an expansion over the last new exit.
+
+    while(1)
+    {
+        Location temp_coordinates;
+
+        position = skip_whitespace(position, end);
+        if(position == end)
+            break; // The last simulation set may end with the file, without a period.
+
+        if( scan_integer(&position, end, &temp_coordinates.lin) == false ||
+            scan_integer(&position, end, &temp_coordinates.col) == false)
+        {
+            fprintf(stderr, "Failure while reading the auxiliary file for exit coordinates. Verify if the syntax is being correctly followed.\n");
+            return FAILURE;
+        }
+
+        position = skip_whitespace(position, end);
+        if(position == end)
+        {
+            fprintf(stderr, "Failure while reading the auxiliary file for exit coordinates. Verify if the syntax is being correctly followed.\n");
+            return FAILURE;
+        }
+
+        if(new_exit == true)
+        {
+            if( add_new_exit(temp_coordinates) == FAILURE)
+                return FAILURE;
+        }
+        else
+        {
+            if( expand_exit(exits_set.list[exits_set.num_exits - 1],temp_coordinates) == FAILURE)
+                return FAILURE;
+        }
+
+        char read_char = auxiliary_data[position++];
+        if(read_char == '+')
+            new_exit = false;
+        else if(read_char == ',')
+            new_exit = true;
+        else if(read_char == '.')
+            break;
+        else
+        {
+            fprintf(stderr, "Unknow symbol in the auxiliary file.\n");
+            return FAILURE;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Unmaps the auxiliary file and deallocates its index.
+*/
+void close_auxiliary_file()
+{
+    if(auxiliary_mapped)
+        munmap((void *) auxiliary_data, auxiliary_size);
+
+    for(int entry_index = 0; entry_index < num_entries; entry_index++)
+        deallocate_set_generator(simulation_set_entries[entry_index].generator);
+
+    free(simulation_set_entries);
+
+    auxiliary_data = NULL;
+    auxiliary_size = 0;
+    auxiliary_mapped = false;
+    simulation_set_entries = NULL;
+    num_entries = 0;
+    simulation_set_quantity = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Stores the offsets of every simulation set of the mapped auxiliary file. A simulation set starts at the first non-whitespace character after the period of the previous set and ends at its own period. Simulation sets that start with @ are generator expressions, which are expanded into the number of sets they produce.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status index_simulation_sets()
+{
+    int capacity = 0;
+    size_t position = 0;
+
+    while(1)
+    {
+        position = skip_whitespace(position, auxiliary_size);
+        if(position == auxiliary_size)
+            break;
+
+        if(num_entries == capacity)
+        {
+            capacity = capacity == 0 ? 64 : capacity * 2;
+
+            Simulation_Set_Entry *temp = realloc(simulation_set_entries, sizeof(Simulation_Set_Entry) * capacity);
+            if(temp == NULL)
+            {
+                fprintf(stderr, "Failure in the allocation of the auxiliary file index.\n");
+                return FAILURE;
+            }
+            simulation_set_entries = temp;
+        }
+
+        const char *period = memchr(auxiliary_data + position, '.', auxiliary_size - position);
+        size_t end = period == NULL ? auxiliary_size : (size_t) (period - auxiliary_data) + 1;
+
+        Simulation_Set_Entry *entry = &simulation_set_entries[num_entries];
+        entry->start = position;
+        entry->end = end;
+        entry->first_set = simulation_set_quantity;
+        entry->num_sets = 1;
+        entry->generator = NULL;
+        num_entries++;
+
+        if(auxiliary_data[position] == '@')
+        {
+            size_t expression_end = period == NULL ? end : end - 1;
+
+            entry->generator = create_set_generator(auxiliary_data + position + 1, expression_end - position - 1);
+            if(entry->generator == NULL)
+                return FAILURE;
+
+            entry->num_sets = get_generated_set_quantity(entry->generator);
+        }
+
+        if(entry->num_sets > INT_MAX - simulation_set_quantity)
+        {
+            fprintf(stderr, "The auxiliary file has too many simulation sets.\n");
+            return FAILURE;
+        }
+        simulation_set_quantity += entry->num_sets;
+
+        position = end;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Advances the position over whitespace characters of the mapped auxiliary file.
+ *
+ * @param position Current position.
+ * @param end Position where the scan must stop.
+ * @return The position of the first non-whitespace character, or end.
+*/
+static size_t skip_whitespace(size_t position, size_t end)
+{
+    while(position < end && isspace((unsigned char) auxiliary_data[position]))
+        position++;
+
+    return position;
+}
+
+/**
+ * Reads a decimal integer (optionally preceded by whitespace and a sign) of the mapped auxiliary file.
+ *
+ * @param position Pointer to the current position, which is advanced past the integer.
+ * @param end Position where the scan must stop.
+ * @param value Pointer to the integer where the read value will be stored.
+ * @return True, if an integer was read, or false, otherwise.
+*/
+static bool scan_integer(size_t *position, size_t end, int *value)
+{
+    size_t current = skip_whitespace(*position, end);
+    bool negative = false;
+    long long number = 0;
+
+    if(current < end && (auxiliary_data[current] == '-' || auxiliary_data[current] == '+'))
+    {
+        negative = auxiliary_data[current] == '-';
+        current++;
+    }
+
+    size_t first_digit = current;
+    while(current < end && isdigit((unsigned char) auxiliary_data[current]))
+    {
+        number = number * 10 + (auxiliary_data[current] - '0');
+        if(number > INT_MAX)
+            return false;
+        current++;
+    }
+
+    if(current == first_digit)
+        return false;
+
+    *value = negative ? (int) -number : (int) number;
+    *position = current;
+
+    return true;
+}
+
+/**
+ * Finds the entry of the index that holds a simulation set.
+ *
+ * @param set_index Index of the simulation set (starting at 0).
+ * @return The index of the entry.
+*/
+static int find_entry(int set_index)
+{
+    int lower = 0, upper = num_entries - 1;
+
+    // Last entry whose first set isn't after set_index; generators without sets share the first set of the next entry.
+    while(lower < upper)
+    {
+        int middle = (lower + upper + 1) / 2;
+
+        if(simulation_set_entries[middle].first_set <= set_index)
+            lower = middle;
+        else
+            upper = middle - 1;
+    }
+
+    return lower;
+}
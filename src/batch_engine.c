@@ -0,0 +1,286 @@
+/*
+   File: batch_engine.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module advances several simulations of the same simulation set together (--batch-seeds), one timestep of each simulation at a time. Each simulation has its own slot, with its pedestrians, position grid and random substreams, which is swapped into the global structures while the simulation runs. The static weights are shared by all the slots and, when alpha is 0, the floor fields don't depend on the pedestrians, so a single floor field is calculated for the whole batch and read by every slot. The simulations are started in the order of their seeds and every random draw comes from the substreams of the pedestrians, so the results are identical to those of the simulations run one at a time.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/batch_engine.h"
+#include"../headers/random_stream.h"
+#include"../headers/timestep_variants.h"
+#include"../headers/watchdog.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    Pedestrian_Set pedestrians;
+    Int_Grid position_grid;
+    Random_Stream_State streams; // While the slot is active, holds the substreams that were in use before it.
+    int number_timesteps;
+    int timesteps_without_progress; // Consecutive timesteps without progress, read by the watchdog.
+    bool is_finished;
+} Simulation_Slot;
+
+static Simulation_Slot *slots = NULL;
+static int num_slots = 0;
+
+static Function_Status allocate_simulation_slots();
+static Function_Status start_slot_simulation(Simulation_Slot *slot, Pedestrian_Set original_pedestrians, int seed);
+static Function_Status advance_slot_simulation(Simulation_Slot *slot, Simulation_Result *result, bool is_field_shared);
+static void finish_slot_simulation(Simulation_Slot *slot, Simulation_Result *result, enum Censoring_Reason censoring);
+static Function_Status calculate_floor_fields();
+static void activate_slot(Simulation_Slot *slot);
+static void deactivate_slot(Simulation_Slot *slot);
+
+/**
+ * Runs the next num_simulations simulations of the current simulation set together, with the seeds starting at cli_args.seed.
+ *
+ * @note The floor fields of the exits must be ready for the placement of the pedestrians, as for a simulation run alone.
+ *
+ * @param num_simulations Number of simulations, up to cli_args.batch_seeds.
+ * @param results Array where the results of each simulation will be stored, in the order of the seeds.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_simulation_batch(int num_simulations, Simulation_Result *results)
+{
+    if(slots == NULL && allocate_simulation_slots() == FAILURE)
+        return FAILURE;
+
+    // Static pedestrians are copied to each slot, while random ones are created by the slots themselves.
+    Pedestrian_Set original_pedestrians = pedestrian_set;
+    Int_Grid original_position_grid = pedestrian_position_grid;
+
+    // Without crowd avoidance, the floor fields are the static weights, shared by every slot and timestep.
+    bool is_field_shared = cli_args.alpha == 0.0;
+
+    Function_Status status = SUCCESS;
+    for(int slot_index = 0; slot_index < num_simulations && status == SUCCESS; slot_index++)
+    {
+        activate_slot(&slots[slot_index]);
+
+        status = start_slot_simulation(&slots[slot_index], original_pedestrians, cli_args.seed + slot_index);
+
+        // The pedestrians of the next simulations are placed after a floor field was calculated, as in the sequential order.
+        if(status == SUCCESS && slot_index == 0)
+            status = calculate_floor_fields();
+
+        deactivate_slot(&slots[slot_index]);
+    }
+
+    int num_running_simulations = num_simulations;
+    while(num_running_simulations > 0 && status == SUCCESS)
+    {
+        for(int slot_index = 0; slot_index < num_simulations && status == SUCCESS; slot_index++)
+        {
+            Simulation_Slot *slot = &slots[slot_index];
+            if(slot->is_finished)
+                continue;
+
+            activate_slot(slot);
+            status = advance_slot_simulation(slot, &results[slot_index], is_field_shared);
+            deactivate_slot(slot);
+
+            if(slot->is_finished)
+                num_running_simulations--;
+        }
+    }
+
+    for(int slot_index = 0; slot_index < num_simulations; slot_index++)
+    {
+        activate_slot(&slots[slot_index]);
+        deallocate_pedestrians();
+        deactivate_slot(&slots[slot_index]);
+    }
+
+    pedestrian_set = original_pedestrians;
+    pedestrian_position_grid = original_position_grid;
+
+    return status;
+}
+
+/**
+ * Deallocates the slots of the simulations.
+*/
+void deallocate_batch_engine()
+{
+    for(int slot_index = 0; slot_index < num_slots; slot_index++)
+    {
+        deallocate_grid((void **) slots[slot_index].position_grid, cli_args.global_line_number);
+        free(slots[slot_index].streams.counters);
+    }
+
+    free(slots);
+    slots = NULL;
+    num_slots = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Allocates cli_args.batch_seeds slots, each with its own position grid.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status allocate_simulation_slots()
+{
+    slots = calloc(cli_args.batch_seeds, sizeof(Simulation_Slot));
+    if(slots == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the simulation slots.\n");
+        return FAILURE;
+    }
+
+    for(num_slots = 0; num_slots < cli_args.batch_seeds; num_slots++)
+    {
+        slots[num_slots].position_grid = allocate_integer_grid(cli_args.global_line_number, cli_args.global_column_number);
+        if(slots[num_slots].position_grid == NULL)
+        {
+            fprintf(stderr, "Failure during the allocation of the position grid of a simulation slot.\n");
+            deallocate_batch_engine();
+            return FAILURE;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Places the pedestrians of the active slot for a new simulation with the given seed.
+ *
+ * @param slot Active slot.
+ * @param original_pedestrians Pedestrians loaded from the environment file, copied to the slot when the origin uses static pedestrians.
+ * @param seed Seed of the simulation.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status start_slot_simulation(Simulation_Slot *slot, Pedestrian_Set original_pedestrians, int seed)
+{
+    slot->number_timesteps = 0;
+    slot->timesteps_without_progress = 0;
+    slot->is_finished = false;
+
+    reset_random_streams(seed);
+
+    if(origin_uses_static_pedestrians() == false)
+        return insert_pedestrians_at_random(cli_args.total_num_pedestrians);
+
+    // The copies receive the same ids, since add_new_pedestrian numbers the pedestrians in the order they are added. As in the sequential order, the initial cells were recorded in the heatmap only when the originals were loaded.
+    for(int p_index = 0; p_index < original_pedestrians.num_pedestrians; p_index++)
+    {
+        if(add_new_pedestrian(original_pedestrians.list[p_index]->origin) == FAILURE)
+            return FAILURE;
+    }
+
+    reset_pedestrians_structures();
+
+    return SUCCESS;
+}
+
+/**
+ * Runs the next timestep of the simulation of the active slot, or finishes it if the environment is empty or the watchdog censors it.
+ *
+ * @param slot Active slot.
+ * @param result Where the result of the simulation will be stored, once it finishes.
+ * @param is_field_shared Indicates that the floor fields were calculated for the whole batch.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status advance_slot_simulation(Simulation_Slot *slot, Simulation_Result *result, bool is_field_shared)
+{
+    if(is_environment_empty())
+    {
+        finish_slot_simulation(slot, result, NOT_CENSORED);
+        return SUCCESS;
+    }
+
+    if(! is_field_shared && calculate_floor_fields() == FAILURE)
+        return FAILURE;
+
+    if(cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
+    {
+        finish_slot_simulation(slot, result, NOT_CENSORED); // The delta only requires the floor fields of the first timestep.
+        return SUCCESS;
+    }
+
+    if(run_timestep() == FAILURE)
+        return FAILURE;
+
+    slot->number_timesteps++;
+
+    if(is_watchdog_enabled() && is_environment_empty() == false)
+    {
+        enum Censoring_Reason censoring = check_simulation_progress(slot->number_timesteps, &slot->timesteps_without_progress);
+        if(censoring != NOT_CENSORED)
+            finish_slot_simulation(slot, result, censoring);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Stores the result of the simulation of the active slot, releasing its pedestrians in the same way as a simulation run alone.
+ *
+ * @param slot Active slot.
+ * @param result Where the result of the simulation will be stored.
+ * @param censoring Reason why the simulation was stopped before the environment was empty, if it was.
+*/
+static void finish_slot_simulation(Simulation_Slot *slot, Simulation_Result *result, enum Censoring_Reason censoring)
+{
+    if(origin_uses_static_pedestrians() == true)
+        reset_pedestrians_structures();
+    else
+        deallocate_pedestrians();
+
+    result->number_timesteps = slot->number_timesteps;
+    result->censoring = censoring;
+    if(cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
+        result->delta = calculate_distribution_delta();
+
+    slot->is_finished = true;
+}
+
+/**
+ * Calculates the dynamic weights and floor fields of every exit, and the final floor field, for the pedestrians of the active slot.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status calculate_floor_fields()
+{
+    if(calculate_all_dynamic_weights() == FAILURE)
+        return FAILURE;
+
+    if(calculate_all_exits_floor_field() == FAILURE)
+        return FAILURE;
+
+    return calculate_final_floor_field();
+}
+
+/**
+ * Makes the pedestrians, position grid and substreams of the slot the ones used by the simulation functions.
+ *
+ * @param slot Slot to be activated.
+*/
+static void activate_slot(Simulation_Slot *slot)
+{
+    pedestrian_set = slot->pedestrians;
+    pedestrian_position_grid = slot->position_grid;
+    swap_random_stream_state(&slot->streams);
+}
+
+/**
+ * Stores the pedestrians of the active slot back into it and restores the substreams that were in use before it.
+ *
+ * @param slot Active slot.
+*/
+static void deactivate_slot(Simulation_Slot *slot)
+{
+    slot->pedestrians = pedestrian_set;
+    swap_random_stream_state(&slot->streams);
+}
@@ -11,9 +11,9 @@
 #include"../headers/cell.h"
 #include"../headers/exit.h"
 #include"../headers/grid.h"
+#include"../headers/random_stream.h"
 #include"../headers/shared_resources.h"
 
-static void insertion_sort(Cell *cell_list, int start_index, int end_index);
 static int count_cells_equal(Cell *cell_list, int list_length, int value_index, int *smaller_index);
 static int partition(Cell *cell_vector, int start_index, int end_index);
 static void swap(Cell *cell_list, int a, int b);
@@ -84,7 +84,9 @@ Cell find_smallest_cell(Location cell_coordinates, bool unoccupied_only)
             same_value++;
         }
 
-        int drawn_cell = rand() % same_value;
+        // The cell is occupied by the pedestrian whose movement is being evaluated, who owns the tie break substream.
+        int pedestrian_id = pedestrian_position_grid[cell_coordinates.lin][cell_coordinates.col];
+        int drawn_cell = draw_random_integer(pedestrian_id, TIE_BREAK_STREAM, same_value);
 
         if(pedestrian_position_grid[neighborhood[drawn_cell].coordinates.lin][neighborhood[drawn_cell].coordinates.col] == 0)
             destination_cell = neighborhood[drawn_cell]; 
@@ -178,11 +180,6 @@ void quick_sort(Cell *cell_list, int start_index, int end_index)
     quick_sort(cell_list, pivot + 1, end_index);
 }
 
-
-/* ---------------- */
-/* STATIC FUNCTIONS */
-/* ---------------- */
-
 /**
  * Sorts the given Cell list in ascending order with the insertion sort algorithm.
  *  
@@ -190,7 +187,7 @@ void quick_sort(Cell *cell_list, int start_index, int end_index)
  * @param start_index The starting index of the interval to be sorted.
  * @param end_index The ending index (inclusive) of the interval to be sorted.
 */
-static void insertion_sort(Cell *cell_list, int start_index, int end_index)
+void insertion_sort(Cell *cell_list, int start_index, int end_index)
 {
     if(start_index < 0 || end_index < 0 || end_index - start_index < 0)
         return; // Invalid Interval
@@ -211,6 +208,11 @@ static void insertion_sort(Cell *cell_list, int start_index, int end_index)
     }
 }
 
+
+/* ---------------- */
+/* STATIC FUNCTIONS */
+/* ---------------- */
+
 /**
  * Search the nearby cells of the given index (in both directions) and count the number of cells with the same value. 
  * 
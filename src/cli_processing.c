@@ -12,6 +12,9 @@
 #include<unistd.h>
 #include<stdbool.h>
 
+#include"../headers/live_stream.h"
+#include"../headers/thread_pool.h"
+#include"../headers/parallel_field.h"
 #include"../headers/cli_processing.h"
 
 const char * argp_program_version = "Implementation of the Alizadeh model for pedestrian evacuation using cellular automata.";
@@ -35,10 +38,50 @@ const char doc[] = "Alizadeh - Simulates pedestrian evacuation using the Alizade
 "\t 2 - Number of timesteps required for the termination of each simulation.\n"
 "\t 3 - Heatmap of the environment cells.\n"
 "\t 4 - Variation in the pedestrian distribution (at the beginning of the simulation) between two doors.\n"
+"\t 5 - Summary statistics of the number of timesteps required for the termination of the simulations of each simulation set.\n"
+"\t 6 - Difference in the number of timesteps between each simulation set and the reference simulation set (the first one with accessible exits), paired by seed.\n"
+"\t 7 - Binary trajectory of the pedestrians, which can be replayed with the replay.sh script.\n"
 "Choice 4 generates numbers between 0 and 1, where values close to 0 indicate a uniform distribution between both doors and values close to 1 indicate a uneven distribution.\n"
+"Choice 5 generates a single line per simulation set, with the following columns: number of simulations, mean, sample variance, minimum, maximum and the 5th, 25th, 50th, 75th and 95th percentiles.\n"
+"Choice 6 requires the --common-random-numbers option and generates a single line per simulation set, with the following columns: number of pairs, mean difference, standard deviation of the differences and half-width of the 95% confidence interval of the mean difference.\n"
+"Choice 7 requires the --output-file option. The environment is written once, followed by the movements and exits of the pedestrians at each timestep.\n"
+"\n"
+"The --heatmap-encoding option specifies how choice 3 is written. The dense encoding writes the mean number of visits of every cell. The sparse encoding writes, for each simulation set, a line with the number of lines, columns and runs, followed by one line per run of cells with visits in the same line: line, first column, length and the mean number of visits of each cell. The binary encoding writes the same runs with the total number of visits, in the format described in heatmap.h, and requires the --output-file option.\n"
 "\n"
 "The --alpha option indicates the importance of the dynamic weight in calculating the floor field value for each cell. Its default value of 0 means that the dynamic weight doesn't matter, and the model behaves the same as the Varas (2007) model.\n"
 "\n"
+"The --ci-tolerance option enables the adaptive number of simulations, available only for the output formats 2 and 5. Each simulation set starts with SIMULATIONS simulations (--simu) and receives batches of SIMULATION-BATCH simulations until the half-width of the 95% confidence interval of the mean number of timesteps falls below the TOLERANCE, or until MAX-SIMULATIONS simulations are reached.\n"
+"\n"
+"The --common-random-numbers option gives each pedestrian an independent random substream for each type of decision (placement, panic, tie break, conflict and X movement), keyed by the seed and the pedestrian id. Furthermore, every simulation set uses the same seeds. This way, the simulations of different simulation sets are positively correlated, which reduces the variance of the comparison between them.\n"
+"\n"
+"The --async-output option hands off each filled output buffer to a writer thread, which writes it while the simulations continue. At the end, the number of written buffers, how many times (and for how long) the simulations waited for a free buffer and the maximum number of queued buffers are printed to stderr.\n"
+"\n"
+"The --compress option compresses the output file while it is written, with gzip or zstd. The level can be appended to the method, as in --compress=zstd:19. When used with --async-output, the compression is done by the writer thread.\n"
+"\n"
+"The --live-stream option publishes the environment at every timestep in a POSIX shared memory ring buffer, which can be watched with the viewer.sh script while the simulations run. The simulations never wait for the viewer, which skips frames when it falls behind.\n"
+"\n"
+"Environment files can be written in the text format or in a binary format (described in environment_file.h), which is smaller and faster to load for large floor plans. The --convert-env option converts the file provided with --env-file to the binary format. Both formats are recognized automatically.\n"
+"\n"
+"The --exit-sets option receives simulation sets written with the syntax of the auxiliary files, such as --exit-sets=\"@doors 2 1 unique.\". Besides explicit coordinates, this syntax accepts generator expressions, which produce many simulation sets (e.g. every pair of doors along the border) without enumerating them in a file. The syntax is described in the project's readme.\n"
+"\n"
+"The --static-field-cache option speeds up searches over exit positions (e.g. auxiliary files with thousands of simulation sets). The static weights of every border cell that can hold an exit are calculated once, in batches of cells that share a single pass over the environment, and reused by every single-cell exit placed there. The results are identical to those calculated without the cache, at the cost of keeping a grid of weights for each border cell in memory.\n"
+"\n"
+"The --threads option sets the number of threads of the parallel computations. In environments with at least --parallel-field-cells cells (such as stadiums with millions of cells), the static weights of each exit are calculated by a parallel wavefront, with the lines of the environment split between the threads. In environments with at least --parallel-exit-cells cells and more than one exit, the static weights, dynamic weights and floor fields of the exits are calculated concurrently, by a pool of threads started once. The results are identical to the sequential calculation.\n"
+"\n"
+"The --parallel-timestep option splits the environment lines between --threads threads, each one calculating the movements of the pedestrians located on its lines, for single evacuations with tens of thousands of pedestrians. Target cells are claimed atomically and every random decision comes from the substreams of the pedestrians, so the results are identical to those of the sequential timestep, whatever the number of threads.\n"
+"\n"
+"The --batch-seeds option advances several simulations of the same simulation set (with consecutive seeds) together, one timestep of each simulation at a time, for small environments simulated many times. The simulations share the static weights and, when alpha is 0, a single floor field calculated once for the whole simulation set, which stay in the cache while the simulations are advanced. The results are printed in the order of the seeds and are identical to those of the simulations run one at a time.\n"
+"\n"
+"The --grid-layout=tiled option calculates the static weights on grids stored in tiles of 8x8 cells, for large environments (from hundreds to thousands of lines and columns). The neighborhoods read by each sweep stay in a few cache lines, and only the tiles whose values changed in the previous sweep are swept again, so the calculation follows the front of the weights instead of sweeping the whole environment. Each exit is calculated by a single thread, instead of the parallel wavefront, and the results are identical to those of the row-major grids. Only the calculation of the static weights uses the tiles: the floor fields and the neighborhoods read by the movements of the pedestrians are kept in row-major grids, with any layout.\n"
+"\n"
+"The --grid-layout=sparse option also calculates the static weights on tiles, and keeps the static weights, dynamic weights and floor field of each exit in tiles of 8x8 cells, allocated only where at least one cell is reachable from the exit. The other tiles, made of walls and unreachable cells, share two values, so maps dominated by walls or unreachable space (such as campuses) use several times less memory. It can't be used with --static-field-cache, and the results are identical to those of the row-major grids.\n"
+"\n"
+"The --spawn-zones option restricts the cells where the pedestrians are randomly placed to a list of rectangles, such as --spawn-zones=\"1 1 10 20, 30 5 40 15\" for the rectangle from (1,1) to (10,20) and the one from (30,5) to (40,15). The free cells of the environment (inside the spawn zones), which are neither walls nor exits, are listed once for each simulation set, and each pedestrian is placed with a single draw among the cells not taken yet, so the placement takes the same time at any density. Asking for more pedestrians than free cells is reported as an error.\n"
+"\n"
+"The --max-timesteps and --stall-timesteps options stop the simulations that don't end, such as those with pedestrians in regions without an exit or stuck in a crowd that never moves. A simulation is censored when it reaches TIMESTEPS timesteps (--max-timesteps) or when no pedestrian makes progress for TIMESTEPS consecutive timesteps (--stall-timesteps), and the run continues with the next simulation. Censored simulations are marked in every output format: choice 1 prints a line after the last timestep, choice 2 appends a + to the number of timesteps (e.g. 5000+), choices 3 (dense and sparse encodings) print the number of censored simulations after the heatmap of the simulation set, when there are any, and choice 7 ends the simulation with a censored record. The binary heatmap encoding writes a censored record before the simulation set (see heatmap.h). Choices 5 and 6 leave the censored simulations out of the statistics (choice 6 leaves out the pairs with a censored simulation on either side), and get an additional last column with the number of censored simulations. Choice 4 only runs the first timestep and is never censored. A pedestrian makes progress when they leave the environment or reach a cell with a floor field value lower than any they reached before, so the pedestrians that keep stepping in a region without an exit don't stop the detection once they have visited all its cells.\n"
+"\n"
+"The --sets option allows the simulation sets of a large auxiliary file to be split between several runs, or a run to be resumed from a given set. The sets are located through an index of the auxiliary file, so the skipped sets aren't read. With --common-random-numbers, every set uses the same seeds and the output of each run matches the corresponding part of the output of a full run; otherwise, the seeds continue from --seed.\n"
+"\n"
 "Unnecessary options for some --env-load-method are ignored.\n";
 
 /* Keys for options without short-options. */
@@ -52,16 +95,44 @@ const char doc[] = "Alizadeh - Simulates pedestrian evacuation using the Alizade
 #define OPT_ALLOW_X_MOVEMENT 1007
 #define OPT_SINGLE_EXIT_FLAG 1008
 #define OPT_ALPHA 1009
+#define OPT_CI_TOLERANCE 1010
+#define OPT_MAX_SIMULATIONS 1011
+#define OPT_SIMULATION_BATCH 1012
+#define OPT_COMMON_RANDOM_NUMBERS 1013
+#define OPT_LIVE_STREAM 1014
+#define OPT_HEATMAP_ENCODING 1015
+#define OPT_ASYNC_OUTPUT 1016
+#define OPT_COMPRESS 1017
+#define OPT_SETS 1018
+#define OPT_EXIT_SETS 1019
+#define OPT_CONVERT_ENV 1020
+#define OPT_STATIC_FIELD_CACHE 1021
+#define OPT_THREADS 1022
+#define OPT_PARALLEL_FIELD_CELLS 1023
+#define OPT_PARALLEL_EXIT_CELLS 1024
+#define OPT_PARALLEL_TIMESTEP 1025
+#define OPT_BATCH_SEEDS 1026
+#define OPT_GRID_LAYOUT 1027
+#define OPT_SPAWN_ZONES 1028
+#define OPT_MAX_TIMESTEPS 1029
+#define OPT_STALL_TIMESTEPS 1030
 
 struct argp_option options[] = {
     {"\nFiles:\n",0,0,OPTION_DOC,0,1},
     {"env-file", 'e', "ENV-FILE", 0, "Name of the file that contains environment information: dimensions and its mapped features, including obstacles, walls, and optionally, pedestrians and doors.",2},
+    {"convert-env", OPT_CONVERT_ENV, "BINARY-FILE", 0, "Converts the environment file to the binary format, storing it in the environments directory with the given name, and exits without running any simulation."},
     {"output-file", 'o', "OUTPUT-FILE", OPTION_ARG_OPTIONAL, "Specifies whether the output should be stored in a file (default is stdout), with the file name being optionally provided."},
     {"auxiliary-file", 'a', "AUXILIARY-FILE",0, "Name of the configuration file that contains the coordinates of exits for each simulation set."},
+    {"exit-sets", OPT_EXIT_SETS, "SETS", 0, "Simulation sets (or generator expressions) written with the syntax of the auxiliary files, used instead of an auxiliary file."},
+    {"sets", OPT_SETS, "FIRST[-LAST]", 0, "Simulates only the simulation sets from FIRST to LAST (default is the last one) of the auxiliary file, numbered from 1."},
 
     {"\nInput/Output Configuration:\n",0,0,OPTION_DOC,0,3},    
     {"env-load-method", 'm', "METHOD",0, "How the environment will be loaded or whether it will be created.",4},
     {"output-format", 'O', "FORMAT", 0, "The type of output to be generated by the simulations."},
+    {"heatmap-encoding", OPT_HEATMAP_ENCODING, "ENCODING", 0, "Encoding of the heatmap output format: dense (default), sparse or binary."},
+    {"compress", OPT_COMPRESS, "METHOD[:LEVEL]", 0, "Compresses the output file with gzip (levels 1 to 9, default is 6) or zstd (levels 1 to 19, default is 3)."},
+    {"async-output", OPT_ASYNC_OUTPUT, 0, 0, "The output file is written by a separate thread, so the simulations don't wait for slow disks or pipes."},
+    {"live-stream", OPT_LIVE_STREAM, "SHM-NAME", OPTION_ARG_OPTIONAL, "Publishes every frame in a shared memory ring buffer (default name is /alizadeh_live), which can be watched with the viewer.sh script."},
     
     {"\nEnvironment Dimensions (required for auto created environments):\n",0,0,OPTION_DOC,0,5},
     {"lin", 'l', "LINES", 0, "Number of lines for the environment when it is being created.",6},
@@ -69,10 +140,21 @@ struct argp_option options[] = {
 
     {"\nSimulation Variables (optional):\n",0,0,OPTION_DOC,0,7},
     {"ped", 'p', "PEDESTRIANS", 0, "Number of pedestrians to be randomly placed in the environment (default is 1).",8},
+    {"spawn-zones", OPT_SPAWN_ZONES, "ZONES", 0, "Rectangles where the pedestrians are randomly placed, separated by commas, each given by the line and column of two opposite corners (default is the whole environment)."},
     {"simu", 's', "SIMULATIONS", 0, "Number of simulations for each simulation set (default is 1)."},
     {"seed", OPT_SEED, "SEED", 0, "Initial seed for the srand function (default is 0)."},
     {"diagonal", OPT_DIAGONAL, "DIAGONAL", 0, "The diagonal value for calculation of the static floor field (default is 1.5)."},
     {"alpha", OPT_ALPHA, "ALPHA", 0, "Coefficient of crowd avoidance (default is 0).", 8},
+    {"ci-tolerance", OPT_CI_TOLERANCE, "TOLERANCE", 0, "Enables the adaptive number of simulations, which stops when the half-width of the 95% confidence interval of the mean number of timesteps is below TOLERANCE."},
+    {"max-simu", OPT_MAX_SIMULATIONS, "MAX-SIMULATIONS", 0, "Maximum number of simulations for each simulation set in the adaptive mode (default is 1000)."},
+    {"simu-batch", OPT_SIMULATION_BATCH, "SIMULATION-BATCH", 0, "Number of simulations added at once to a simulation set in the adaptive mode (default is 10)."},
+    {"threads", OPT_THREADS, "THREADS", 0, "Number of threads used by the parallel computations (default is the number of processors)."},
+    {"parallel-field-cells", OPT_PARALLEL_FIELD_CELLS, "CELLS", 0, "Minimum number of cells of the environment for the static weights to be calculated in parallel (default is 1000000)."},
+    {"parallel-exit-cells", OPT_PARALLEL_EXIT_CELLS, "CELLS", 0, "Minimum number of cells of the environment for the grids of each exit to be calculated concurrently (default is 10000)."},
+    {"batch-seeds", OPT_BATCH_SEEDS, "SEEDS", 0, "Number of simulations of each simulation set advanced together, timestep by timestep (default is 1). Requires the --common-random-numbers option."},
+    {"grid-layout", OPT_GRID_LAYOUT, "LAYOUT", 0, "Layout of the grids of the exits: row-major (default), tiled or sparse, for large environments."},
+    {"max-timesteps", OPT_MAX_TIMESTEPS, "TIMESTEPS", 0, "Maximum number of timesteps of each simulation, after which the simulation is stopped and reported as censored (default is 0, without maximum)."},
+    {"stall-timesteps", OPT_STALL_TIMESTEPS, "TIMESTEPS", 0, "Number of consecutive timesteps without any pedestrian leaving the environment or getting closer to an exit than before, after which the simulation is stopped and reported as censored (default is 0, disabled)."},
 
     {"\nToggle Options (optional):\n",0,0,OPTION_DOC,0,9},
     {"debug", OPT_DEBUG, 0,0 , "Prints debug information to stdout.",10},
@@ -82,6 +164,9 @@ struct argp_option options[] = {
     {"avoid-corner-movement",OPT_AVOID_CORNER_MOVEMENT,0,0, "Prevents movement in the corners of walls and obstacles. A single diagonal movement through the corner of a obstacle becomes three movements."},
     {"allow-x-movement",OPT_ALLOW_X_MOVEMENT,0,0, "The movement of pedestrians isn't restricted when X movements occur."},
     {"single-exit-flag", OPT_SINGLE_EXIT_FLAG, 0,0, "Prints a flag (#1) before the results for every simulation set that has only one exit."},
+    {"common-random-numbers", OPT_COMMON_RANDOM_NUMBERS, 0,0, "Each pedestrian uses its own random substreams and every simulation set uses the same seeds."},
+    {"static-field-cache", OPT_STATIC_FIELD_CACHE, 0,0, "Keeps the static weights of single-cell exits, which are calculated for every border cell at once and reused by all simulation sets."},
+    {"parallel-timestep", OPT_PARALLEL_TIMESTEP, 0,0, "The movements of the pedestrians in each timestep are calculated by --threads threads, for very large crowds. Requires the --common-random-numbers option."},
 
     {"\nAdditional Information:\n",0,0,OPTION_DOC,0,11},
     {0}
@@ -94,7 +179,14 @@ Command_Line_Args cli_args = {
     .environment_filename="varas_queue.txt",
     .output_filename="",
     .auxiliary_filename="",
+    .live_stream_name="", // The live stream is disabled by default.
+    .exit_sets="",
+    .spawn_zones="", // The pedestrians are placed in the whole environment by default.
+    .converted_environment_filename="",
     .output_format = OUTPUT_VISUALIZATION,
+    .heatmap_encoding = HEATMAP_DENSE,
+    .grid_layout = ROW_MAJOR_LAYOUT,
+    .compression_method = NO_COMPRESSION,
     .environment_origin = STRUCTURE_DOORS_AND_PEDESTRIANS,
     .write_to_file=false,
     .show_debug_information=false,
@@ -104,13 +196,29 @@ Command_Line_Args cli_args = {
     .prevent_corner_crossing=false,
     .allow_X_movement = false,
     .single_exit_flag = false,
+    .common_random_numbers = false,
+    .async_output = false,
+    .static_field_cache = false,
+    .parallel_timestep = false,
     .global_line_number = 0,
     .global_column_number = 0,
     .num_simulations = 1, // A single simulation by default.
+    .max_simulations = 1000,
+    .simulation_batch = 10,
     .total_num_pedestrians = 1,
     .seed = 0,
+    .compression_level = 0,
+    .first_set = 1,
+    .last_set = 0, // Up to the last simulation set by default.
+    .num_threads = 0, // One thread per processor by default.
+    .parallel_field_cells = DEFAULT_PARALLEL_FIELD_CELLS,
+    .parallel_exit_cells = DEFAULT_PARALLEL_EXIT_CELLS,
+    .batch_seeds = 1, // The simulations run one at a time by default.
+    .max_timesteps = 0, // The simulations run until the environment is empty by default.
+    .stall_timesteps = 0,
     .alpha = 0.0,
-    .diagonal = 1.5
+    .diagonal = 1.5,
+    .ci_tolerance = 0.0 // The adaptive number of simulations is disabled by default.
 };
 // When loading an environment global_line_number and global_column_number will no be obtained from the command line arguments. Besides, total_num_pedestrians will be automatic determined by the program on some environment origin formats.
 
@@ -140,7 +248,7 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
             break;
         case 'O':
             int output_format = atoi(arg);
-            if(output_format < OUTPUT_VISUALIZATION || output_format > OUTPUT_DISTRIBUTION_VARIATION)
+            if(output_format < OUTPUT_VISUALIZATION || output_format > OUTPUT_TRAJECTORY)
             {
                 fprintf(stderr, "Invalid output format.\n");
                 return EIO;
@@ -214,6 +322,78 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
         case OPT_ALPHA:
             cli_args->alpha = atof(arg); 
             break;
+        case OPT_CI_TOLERANCE:
+            cli_args->ci_tolerance = atof(arg);
+            if(cli_args->ci_tolerance <= 0)
+            {
+                fprintf(stderr, "The confidence interval tolerance must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_MAX_SIMULATIONS:
+            cli_args->max_simulations = atoi(arg);
+            if(cli_args->max_simulations <= 0)
+            {
+                fprintf(stderr, "The maximum number of simulations must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_SIMULATION_BATCH:
+            cli_args->simulation_batch = atoi(arg);
+            if(cli_args->simulation_batch <= 0)
+            {
+                fprintf(stderr, "The simulation batch must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_THREADS:
+            cli_args->num_threads = atoi(arg);
+            if(cli_args->num_threads <= 0)
+            {
+                fprintf(stderr, "The number of threads must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_PARALLEL_FIELD_CELLS:
+            cli_args->parallel_field_cells = atoi(arg);
+            if(cli_args->parallel_field_cells <= 0)
+            {
+                fprintf(stderr, "The minimum number of cells for the parallel static weights must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_PARALLEL_EXIT_CELLS:
+            cli_args->parallel_exit_cells = atoi(arg);
+            if(cli_args->parallel_exit_cells <= 0)
+            {
+                fprintf(stderr, "The minimum number of cells for the concurrent exits must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_BATCH_SEEDS:
+            cli_args->batch_seeds = atoi(arg);
+            if(cli_args->batch_seeds <= 0)
+            {
+                fprintf(stderr, "The number of simulations advanced together must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_MAX_TIMESTEPS:
+            cli_args->max_timesteps = atoi(arg);
+            if(cli_args->max_timesteps <= 0)
+            {
+                fprintf(stderr, "The maximum number of timesteps must be positive.\n");
+                return EIO;
+            }
+            break;
+        case OPT_STALL_TIMESTEPS:
+            cli_args->stall_timesteps = atoi(arg);
+            if(cli_args->stall_timesteps <= 0)
+            {
+                fprintf(stderr, "The number of timesteps without progress must be positive.\n");
+                return EIO;
+            }
+            break;
         case OPT_DEBUG:
             cli_args->show_debug_information = true;
             break;
@@ -235,6 +415,117 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
         case OPT_SINGLE_EXIT_FLAG:
             cli_args->single_exit_flag = true;
             break;
+        case OPT_COMMON_RANDOM_NUMBERS:
+            cli_args->common_random_numbers = true;
+            break;
+        case OPT_ASYNC_OUTPUT:
+            cli_args->async_output = true;
+            break;
+        case OPT_STATIC_FIELD_CACHE:
+            cli_args->static_field_cache = true;
+            break;
+        case OPT_PARALLEL_TIMESTEP:
+            cli_args->parallel_timestep = true;
+            break;
+        case OPT_COMPRESS:
+            char *level = strchr(arg, ':');
+            int method_length = level == NULL ? (int) strlen(arg) : level - arg;
+
+            if(strncmp(arg, "gzip", method_length) == 0 && method_length == 4)
+                cli_args->compression_method = GZIP_COMPRESSION;
+            else if(strncmp(arg, "zstd", method_length) == 0 && method_length == 4)
+                cli_args->compression_method = ZSTD_COMPRESSION;
+            else
+            {
+                fprintf(stderr, "Invalid compression method.\n");
+                return EIO;
+            }
+
+            if(level != NULL)
+            {
+                cli_args->compression_level = atoi(level + 1);
+                int maximum_level = cli_args->compression_method == GZIP_COMPRESSION ? 9 : 19;
+                if(cli_args->compression_level < 1 || cli_args->compression_level > maximum_level)
+                {
+                    fprintf(stderr, "The compression level must be between 1 and %d.\n", maximum_level);
+                    return EIO;
+                }
+            }
+            break;
+        case OPT_CONVERT_ENV:
+            if(strlen(arg) >= sizeof(cli_args->converted_environment_filename))
+            {
+                fprintf(stderr, "The --convert-env argument is too long.\n");
+                return EIO;
+            }
+            strcpy(cli_args->converted_environment_filename, arg);
+            break;
+        case OPT_EXIT_SETS:
+            if(strlen(arg) >= sizeof(cli_args->exit_sets) - 10) // The full command keeps the option with its quotes.
+            {
+                fprintf(stderr, "The --exit-sets argument is too long; use an auxiliary file instead.\n");
+                return EIO;
+            }
+            strcpy(cli_args->exit_sets, arg);
+            break;
+        case OPT_SPAWN_ZONES:
+            if(strlen(arg) >= sizeof(cli_args->spawn_zones) - 10) // The full command keeps the option with its quotes.
+            {
+                fprintf(stderr, "The --spawn-zones argument is too long.\n");
+                return EIO;
+            }
+            strcpy(cli_args->spawn_zones, arg);
+            break;
+        case OPT_SETS:
+            {
+                char *last = strchr(arg, '-');
+
+                cli_args->first_set = atoi(arg);
+                cli_args->last_set = last == NULL ? 0 : atoi(last + 1);
+                if(cli_args->first_set <= 0 || (last != NULL && cli_args->last_set < cli_args->first_set))
+                {
+                    fprintf(stderr, "The range of simulation sets must be FIRST or FIRST-LAST, with 1 <= FIRST <= LAST.\n");
+                    return EIO;
+                }
+            }
+            break;
+        case OPT_HEATMAP_ENCODING:
+            if(strcmp(arg, "dense") == 0)
+                cli_args->heatmap_encoding = HEATMAP_DENSE;
+            else if(strcmp(arg, "sparse") == 0)
+                cli_args->heatmap_encoding = HEATMAP_SPARSE;
+            else if(strcmp(arg, "binary") == 0)
+                cli_args->heatmap_encoding = HEATMAP_BINARY;
+            else
+            {
+                fprintf(stderr, "Invalid heatmap encoding.\n");
+                return EIO;
+            }
+            break;
+        case OPT_GRID_LAYOUT:
+            if(strcmp(arg, "row-major") == 0)
+                cli_args->grid_layout = ROW_MAJOR_LAYOUT;
+            else if(strcmp(arg, "tiled") == 0)
+                cli_args->grid_layout = TILED_LAYOUT;
+            else if(strcmp(arg, "sparse") == 0)
+                cli_args->grid_layout = SPARSE_LAYOUT;
+            else
+            {
+                fprintf(stderr, "Invalid grid layout.\n");
+                return EIO;
+            }
+            break;
+        case OPT_LIVE_STREAM:
+            if(arg == NULL)
+                strcpy(cli_args->live_stream_name, LIVE_STREAM_DEFAULT_NAME);
+            else if(strlen(arg) == 0 || strlen(arg) > 140 || strchr(arg + 1, '/') != NULL)
+            {
+                fprintf(stderr, "Invalid shared memory name for the live stream.\n");
+                return EIO;
+            }
+            else
+                sprintf(cli_args->live_stream_name, "%s%s", arg[0] == '/' ? "" : "/", arg); // POSIX shared memory names start with a slash.
+            break;
         case ARGP_KEY_ARG:
             fprintf(stderr, "No positional argument was expect, but %s was given.\n", arg);
             return EINVAL;
@@ -242,9 +533,15 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
         case ARGP_KEY_END:
             if(origin_uses_auxiliary_data() == true)
             {
-                if( strcmp(cli_args->auxiliary_filename,"") == 0)
+                if( strcmp(cli_args->auxiliary_filename,"") == 0 && strcmp(cli_args->exit_sets,"") == 0)
                 {
-                    fprintf(stderr, "--env-load-method 1, 3 and 5 require an auxiliary file to be provided.\n");
+                    fprintf(stderr, "--env-load-method 1, 3 and 5 require an auxiliary file (or the --exit-sets option) to be provided.\n");
+                    return EIO;
+                }
+
+                if( strcmp(cli_args->auxiliary_filename,"") != 0 && strcmp(cli_args->exit_sets,"") != 0)
+                {
+                    fprintf(stderr, "The --exit-sets option can't be used with an auxiliary file.\n");
                     return EIO;
                 }
             }
@@ -252,6 +549,17 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
             {
                 if( strcmp(cli_args->auxiliary_filename,"") != 0)
                     strcpy(cli_args->auxiliary_filename,""); // when the auxiliary file is not needed.
+
+                strcpy(cli_args->exit_sets,"");
+
+                cli_args->first_set = 1; // Origins that use static exits have a single simulation set.
+                cli_args->last_set = 0;
+            }
+
+            if(strcmp(cli_args->spawn_zones, "") != 0 && origin_uses_static_pedestrians() == true)
+            {
+                fprintf(stderr, "The --spawn-zones option requires an --env-load-method that places the pedestrians at random (1, 2 or 5).\n");
+                return EIO;
             }
 
             if(cli_args->environment_origin == AUTOMATIC_CREATED)
@@ -263,6 +571,99 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
                 }
             }
 
+            if(cli_args->output_format == OUTPUT_TRAJECTORY && cli_args->write_to_file == false)
+            {
+                fprintf(stderr, "The output format 7 requires the --output-file option.\n");
+                return EIO;
+            }
+
+            if(cli_args->compression_method != NO_COMPRESSION && cli_args->write_to_file == false)
+            {
+                fprintf(stderr, "The --compress option requires the --output-file option.\n");
+                return EIO;
+            }
+
+            if(cli_args->async_output && cli_args->write_to_file == false)
+            {
+                fprintf(stderr, "The --async-output option requires the --output-file option.\n");
+                return EIO;
+            }
+
+            if(cli_args->heatmap_encoding == HEATMAP_BINARY && (cli_args->output_format != OUTPUT_HEATMAP || cli_args->write_to_file == false))
+            {
+                fprintf(stderr, "The binary heatmap encoding requires the output format 3 and the --output-file option.\n");
+                return EIO;
+            }
+
+            if(cli_args->output_format == OUTPUT_PAIRED_DIFFERENCE && cli_args->common_random_numbers == false)
+            {
+                fprintf(stderr, "The output format 6 requires the --common-random-numbers option.\n");
+                return EIO;
+            }
+
+            if(cli_args->num_threads == 0)
+            {
+                long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+                cli_args->num_threads = num_processors > 0 ? (int) num_processors : 1;
+            }
+
+            if(cli_args->parallel_timestep)
+            {
+                if(cli_args->common_random_numbers == false)
+                {
+                    fprintf(stderr, "The --parallel-timestep option requires the --common-random-numbers option.\n");
+                    return EIO;
+                }
+
+                if(cli_args->show_debug_information)
+                {
+                    fprintf(stderr, "The --parallel-timestep option can't be used with the --debug option.\n");
+                    return EIO;
+                }
+            }
+
+            if(cli_args->grid_layout == SPARSE_LAYOUT && cli_args->static_field_cache)
+            {
+                fprintf(stderr, "The --static-field-cache option can't be used with the sparse grid layout.\n");
+                return EIO;
+            }
+
+            if(cli_args->batch_seeds > 1)
+            {
+                if(cli_args->common_random_numbers == false)
+                {
+                    fprintf(stderr, "The --batch-seeds option requires the --common-random-numbers option.\n");
+                    return EIO;
+                }
+
+                if(cli_args->output_format == OUTPUT_VISUALIZATION || cli_args->output_format == OUTPUT_TRAJECTORY)
+                {
+                    fprintf(stderr, "The --batch-seeds option can't be used with the output formats 1 and 7.\n");
+                    return EIO;
+                }
+
+                if(cli_args->show_debug_information || strcmp(cli_args->live_stream_name, "") != 0)
+                {
+                    fprintf(stderr, "The --batch-seeds option can't be used with the --debug and --live-stream options.\n");
+                    return EIO;
+                }
+            }
+
+            if(cli_args->ci_tolerance > 0)
+            {
+                if(cli_args->output_format != OUTPUT_TIMESTEPS_COUNT && cli_args->output_format != OUTPUT_TIMESTEPS_STATISTICS)
+                {
+                    fprintf(stderr, "The adaptive number of simulations (--ci-tolerance) requires the output format 2 or 5.\n");
+                    return EIO;
+                }
+
+                if(cli_args->max_simulations < cli_args->num_simulations)
+                {
+                    fprintf(stderr, "The maximum number of simulations must not be smaller than the number of simulations.\n");
+                    return EIO;
+                }
+            }
+
             break;
         default:
             return ARGP_ERR_UNKNOWN;
@@ -282,7 +683,7 @@ error_t parser_function(int key, char *arg, struct argp_state *state)
 */
 void extract_full_command(char *full_command, int key, char *arg)
 {
-    char aux[151];
+    char aux[170]; // Fits the options whose arguments are kept in 150 character buffers.
 
     switch(key)
     {
@@ -307,6 +708,45 @@ void extract_full_command(char *full_command, int key, char *arg)
         case OPT_SINGLE_EXIT_FLAG:
             sprintf(aux, " --single-exit-flag");
             break;
+        case OPT_COMMON_RANDOM_NUMBERS:
+            sprintf(aux, " --common-random-numbers");
+            break;
+        case OPT_ASYNC_OUTPUT:
+            sprintf(aux, " --async-output");
+            break;
+        case OPT_STATIC_FIELD_CACHE:
+            sprintf(aux, " --static-field-cache");
+            break;
+        case OPT_PARALLEL_TIMESTEP:
+            sprintf(aux, " --parallel-timestep");
+            break;
+        case OPT_COMPRESS:
+            sprintf(aux, " --compress=%s", arg);
+            break;
+        case OPT_SETS:
+            sprintf(aux, " --sets=%s", arg);
+            break;
+        case OPT_CONVERT_ENV:
+            snprintf(aux, sizeof(aux), " --convert-env=%s", arg); // Bounded, since the length is only checked by parser_function.
+            break;
+        case OPT_EXIT_SETS:
+            snprintf(aux, sizeof(aux), " --exit-sets=\"%s\"", arg); // Bounded, since the length is only checked by parser_function.
+            break;
+        case OPT_SPAWN_ZONES:
+            snprintf(aux, sizeof(aux), " --spawn-zones=\"%s\"", arg); // Bounded, since the length is only checked by parser_function.
+            break;
+        case OPT_HEATMAP_ENCODING:
+            sprintf(aux, " --heatmap-encoding=%s", arg);
+            break;
+        case OPT_GRID_LAYOUT:
+            sprintf(aux, " --grid-layout=%s", arg);
+            break;
+        case OPT_LIVE_STREAM:
+            if(arg == NULL)
+                sprintf(aux, " --live-stream");
+            else
+                sprintf(aux, " --live-stream=%s", arg);
+            break;
         case OPT_SEED:
             sprintf(aux, " --seed=%s", arg);
             break;
@@ -316,6 +756,33 @@ void extract_full_command(char *full_command, int key, char *arg)
         case OPT_ALPHA:
             sprintf(aux, " --alpha=%s",arg);
             break;
+        case OPT_CI_TOLERANCE:
+            sprintf(aux, " --ci-tolerance=%s",arg);
+            break;
+        case OPT_MAX_SIMULATIONS:
+            sprintf(aux, " --max-simu=%s",arg);
+            break;
+        case OPT_SIMULATION_BATCH:
+            sprintf(aux, " --simu-batch=%s",arg);
+            break;
+        case OPT_THREADS:
+            sprintf(aux, " --threads=%s",arg);
+            break;
+        case OPT_PARALLEL_FIELD_CELLS:
+            sprintf(aux, " --parallel-field-cells=%s",arg);
+            break;
+        case OPT_PARALLEL_EXIT_CELLS:
+            sprintf(aux, " --parallel-exit-cells=%s",arg);
+            break;
+        case OPT_BATCH_SEEDS:
+            sprintf(aux, " --batch-seeds=%s",arg);
+            break;
+        case OPT_MAX_TIMESTEPS:
+            sprintf(aux, " --max-timesteps=%s",arg);
+            break;
+        case OPT_STALL_TIMESTEPS:
+            sprintf(aux, " --stall-timesteps=%s",arg);
+            break;
         case 'o':
         case 'O':
         case 'e':
@@ -0,0 +1,245 @@
+/*
+   File: compression.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module compresses the output stream in-process, with gzip (zlib) or zstd. The compressed stream is a stdio stream whose writes are compressed and written to the original output file, so every output format can use it unchanged. The libraries are optional at compile time (HAVE_ZLIB and HAVE_ZSTD, defined by alizadeh.sh when their headers are found).
+*/
+
+#define _GNU_SOURCE // Required for fopencookie.
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+
+#ifdef HAVE_ZLIB
+#include<zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include<zstd.h>
+#endif
+
+#include"../headers/compression.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static FILE *compressed_destination = NULL; // Original output file, which receives the compressed data.
+static unsigned char *compressed_chunk = NULL;
+
+#ifdef HAVE_ZLIB
+static z_stream gzip_stream;
+#endif
+
+#ifdef HAVE_ZSTD
+static ZSTD_CStream *zstd_stream = NULL;
+#endif
+
+static ssize_t compressed_cookie_write(void *cookie, const char *data, size_t size);
+static int compressed_cookie_close(void *cookie);
+static Function_Status compress_data(const char *data, size_t size, bool finish);
+
+/**
+ * Creates a stream that compresses everything written to it, with the method and level given by --compress, and writes the result to the destination.
+ *
+ * @note Closing the returned stream finishes the compression and closes the destination.
+ *
+ * @param destination Stream where the compressed data will be written.
+ * @return A NULL pointer, on error, or the compressed stream.
+*/
+FILE *open_compressed_stream(FILE *destination)
+{
+    compressed_chunk = malloc(COMPRESSED_CHUNK_SIZE);
+    if(compressed_chunk == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the compression buffer.\n");
+        return NULL;
+    }
+
+    if(cli_args.compression_method == GZIP_COMPRESSION)
+    {
+#ifdef HAVE_ZLIB
+        int level = cli_args.compression_level > 0 ? cli_args.compression_level : GZIP_DEFAULT_LEVEL;
+
+        memset(&gzip_stream, 0, sizeof(gzip_stream));
+        // 15 + 16 bits of window select the largest window with a gzip header and trailer.
+        if(deflateInit2(&gzip_stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            fprintf(stderr, "It was not possible to initialize the gzip compression.\n");
+            return NULL;
+        }
+#else
+        fprintf(stderr, "This build doesn't support gzip compression (zlib.h wasn't found at compile time).\n");
+        return NULL;
+#endif
+    }
+    else
+    {
+#ifdef HAVE_ZSTD
+        int level = cli_args.compression_level > 0 ? cli_args.compression_level : ZSTD_DEFAULT_LEVEL;
+
+        zstd_stream = ZSTD_createCStream();
+        if(zstd_stream == NULL || ZSTD_isError(ZSTD_initCStream(zstd_stream, level)))
+        {
+            fprintf(stderr, "It was not possible to initialize the zstd compression.\n");
+            return NULL;
+        }
+#else
+        fprintf(stderr, "This build doesn't support zstd compression (zstd.h wasn't found at compile time).\n");
+        return NULL;
+#endif
+    }
+
+    compressed_destination = destination;
+
+    cookie_io_functions_t compressed_functions = {.write = compressed_cookie_write, .close = compressed_cookie_close};
+    FILE *compressed_stream = fopencookie(NULL, "w", compressed_functions);
+    if(compressed_stream == NULL)
+        fprintf(stderr, "It was not possible to create the compressed output stream.\n");
+
+    return compressed_stream;
+}
+
+/**
+ * Returns the extension appended to the automatically generated output file names for the selected compression method.
+ *
+ * @return ".gz", ".zst" or an empty string, when the output isn't compressed.
+*/
+const char *get_compression_extension()
+{
+    if(cli_args.compression_method == GZIP_COMPRESSION)
+        return ".gz";
+    else if(cli_args.compression_method == ZSTD_COMPRESSION)
+        return ".zst";
+
+    return "";
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Called by stdio whenever the buffer of the compressed stream is flushed.
+ *
+ * @param cookie Unused.
+ * @param data Data to be compressed.
+ * @param size Number of bytes of data.
+ * @return The number of bytes consumed (size) or -1 on error.
+*/
+static ssize_t compressed_cookie_write(void *cookie, const char *data, size_t size)
+{
+    (void) cookie;
+
+    if(compress_data(data, size, false) == FAILURE)
+        return -1;
+
+    return size;
+}
+
+/**
+ * Called by stdio when the compressed stream is closed. Finishes the compressed data and closes the destination.
+ *
+ * @param cookie Unused.
+ * @return 0 on success or EOF on error.
+*/
+static int compressed_cookie_close(void *cookie)
+{
+    (void) cookie;
+
+    Function_Status status = compress_data(NULL, 0, true);
+
+#ifdef HAVE_ZLIB
+    if(cli_args.compression_method == GZIP_COMPRESSION)
+        deflateEnd(&gzip_stream);
+#endif
+
+#ifdef HAVE_ZSTD
+    ZSTD_freeCStream(zstd_stream);
+    zstd_stream = NULL;
+#endif
+
+    if(compressed_destination != stdout)
+    {
+        if(fclose(compressed_destination) != 0)
+            status = FAILURE;
+    }
+    else if(fflush(stdout) != 0)
+        status = FAILURE;
+
+    free(compressed_chunk);
+    compressed_chunk = NULL;
+    compressed_destination = NULL;
+
+    return status == SUCCESS ? 0 : EOF;
+}
+
+/**
+ * Compresses the given data and writes every completed chunk of compressed data to the destination.
+ *
+ * @param data Data to be compressed (NULL when finishing).
+ * @param size Number of bytes of data.
+ * @param finish Whether the compressed data must be finished (flushing the compressor and writing the trailer).
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status compress_data(const char *data, size_t size, bool finish)
+{
+#ifdef HAVE_ZLIB
+    if(cli_args.compression_method == GZIP_COMPRESSION)
+    {
+        gzip_stream.next_in = (Bytef *) data;
+        gzip_stream.avail_in = size;
+
+        int result;
+        do
+        {
+            gzip_stream.next_out = compressed_chunk;
+            gzip_stream.avail_out = COMPRESSED_CHUNK_SIZE;
+
+            result = deflate(&gzip_stream, finish ? Z_FINISH : Z_NO_FLUSH);
+            if(result == Z_STREAM_ERROR)
+            {
+                fprintf(stderr, "Failure during the gzip compression of the output.\n");
+                return FAILURE;
+            }
+
+            size_t compressed_size = COMPRESSED_CHUNK_SIZE - gzip_stream.avail_out;
+            if(fwrite(compressed_chunk, 1, compressed_size, compressed_destination) != compressed_size)
+                return FAILURE;
+        }while(gzip_stream.avail_out == 0 || (finish && result != Z_STREAM_END));
+
+        return SUCCESS;
+    }
+#endif
+
+#ifdef HAVE_ZSTD
+    if(cli_args.compression_method == ZSTD_COMPRESSION)
+    {
+        ZSTD_inBuffer input = {data, size, 0};
+        size_t remaining;
+
+        do
+        {
+            ZSTD_outBuffer output = {compressed_chunk, COMPRESSED_CHUNK_SIZE, 0};
+
+            remaining = ZSTD_compressStream2(zstd_stream, &output, &input, finish ? ZSTD_e_end : ZSTD_e_continue);
+            if(ZSTD_isError(remaining))
+            {
+                fprintf(stderr, "Failure during the zstd compression of the output: %s.\n", ZSTD_getErrorName(remaining));
+                return FAILURE;
+            }
+
+            if(fwrite(compressed_chunk, 1, output.pos, compressed_destination) != output.pos)
+                return FAILURE;
+        }while(input.pos < input.size || (finish && remaining != 0));
+
+        return SUCCESS;
+    }
+#endif
+
+    // Without the compression libraries, the parameters are unused.
+    (void) data;
+    (void) size;
+    (void) finish;
+
+    return FAILURE;
+}
@@ -0,0 +1,481 @@
+/*
+   File: environment_file.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module reads environment files, in the text format or in the binary format described in environment_file.h. The file is memory-mapped and scanned directly, and every cell is handed to a symbol handler, so both formats are loaded with the same rules. It also converts environment files to the binary format, which is smaller and faster to load for large floor plans.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<ctype.h>
+#include<limits.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+#include"../headers/trajectory.h"
+#include"../headers/environment_file.h"
+#include"../headers/shared_resources.h"
+
+const char *environment_path = "environments/";
+
+static char *converted_cells = NULL; // Symbol of every cell of the environment being converted.
+static int converted_lines = 0;
+static int converted_columns = 0;
+
+static Function_Status read_text_environment(const char *data, size_t size, Dimensions_Handler dimensions_handler, Symbol_Handler symbol_handler);
+static Function_Status read_binary_environment(const char *data, size_t size, Dimensions_Handler dimensions_handler, Symbol_Handler symbol_handler);
+static Function_Status read_cell_list(const char **position, const char *end, long long num_cells, int columns, char symbol, Symbol_Handler symbol_handler);
+static Function_Status read_varint(const char **position, const char *end, unsigned int *value);
+static bool scan_dimension(const char **position, const char *end, int *value);
+static Function_Status store_converted_dimensions(int lines, int columns);
+static Function_Status store_converted_symbol(char read_char, Location coordinates);
+static void write_cell_list(FILE *converted_file, char symbol);
+
+/**
+ * Reads an environment file (text or binary format, identified by its first bytes), handing its dimensions and then the symbol of each of its cells to the given handlers.
+ *
+ * @note In the binary format, the cells are handed as walls and empty cells, followed by the exits ('_') and the pedestrians ('p').
+ *
+ * @param filename Name of the file, inside the environments directory.
+ * @param dimensions_handler Function called with the dimensions of the environment, before any cell.
+ * @param symbol_handler Function called with the symbol and the coordinates of each cell.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status read_environment_file(const char *filename, Dimensions_Handler dimensions_handler, Symbol_Handler symbol_handler)
+{
+    char complete_path[300] = "";
+
+    sprintf(complete_path,"%s%s",environment_path,filename);
+
+    int file_descriptor = open(complete_path, O_RDONLY);
+    if(file_descriptor == -1)
+    {
+        fprintf(stderr,"It was not possible to open the environment file: %s.\n",filename);
+        return FAILURE;
+    }
+
+    struct stat file_information;
+    if(fstat(file_descriptor, &file_information) == -1 || file_information.st_size == 0)
+    {
+        fprintf(stderr, "Environment dimensions weren't found in the first line of the file.\n");
+        close(file_descriptor);
+        return FAILURE;
+    }
+
+    size_t size = file_information.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor); // The mapping remains valid after the descriptor is closed.
+    if(mapping == MAP_FAILED)
+    {
+        fprintf(stderr,"It was not possible to map the environment file in memory: %s.\n",filename);
+        return FAILURE;
+    }
+
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    Function_Status status;
+    if(size >= strlen(ENVIRONMENT_MAGIC) && memcmp(mapping, ENVIRONMENT_MAGIC, strlen(ENVIRONMENT_MAGIC)) == 0)
+        status = read_binary_environment(mapping, size, dimensions_handler, symbol_handler);
+    else
+        status = read_text_environment(mapping, size, dimensions_handler, symbol_handler);
+
+    munmap(mapping, size);
+
+    return status;
+}
+
+/**
+ * Converts an environment file (text or binary format) to the binary format.
+ *
+ * @param filename Name of the file to be converted, inside the environments directory.
+ * @param converted_filename Name of the converted file, inside the environments directory.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status convert_environment_file(const char *filename, const char *converted_filename)
+{
+    char complete_path[300] = "";
+
+    Function_Status status = read_environment_file(filename, store_converted_dimensions, store_converted_symbol);
+    if(status == FAILURE)
+    {
+        free(converted_cells);
+        converted_cells = NULL;
+        return FAILURE;
+    }
+
+    sprintf(complete_path,"%s%s",environment_path,converted_filename);
+
+    FILE *converted_file = fopen(complete_path, "wb");
+    if(converted_file == NULL)
+    {
+        fprintf(stderr, "It was not possible to open the converted environment file.\n");
+        free(converted_cells);
+        converted_cells = NULL;
+        return FAILURE;
+    }
+
+    fwrite(ENVIRONMENT_MAGIC, 1, strlen(ENVIRONMENT_MAGIC), converted_file);
+    write_varint(converted_file, ENVIRONMENT_VERSION);
+    write_varint(converted_file, converted_lines);
+    write_varint(converted_file, converted_columns);
+
+    long long num_cells = (long long) converted_lines * converted_columns;
+
+    // Counts the runs before writing them, as the number of runs comes first.
+    unsigned int num_runs = 1;
+    bool previous_wall = false;
+    for(long long cell = 0; cell < num_cells; cell++)
+    {
+        bool wall = converted_cells[cell] == '#' || converted_cells[cell] == '_';
+        if(wall != previous_wall)
+            num_runs++;
+        previous_wall = wall;
+    }
+
+    write_varint(converted_file, num_runs);
+
+    unsigned int run_length = 0;
+    previous_wall = false;
+    for(long long cell = 0; cell < num_cells; cell++)
+    {
+        bool wall = converted_cells[cell] == '#' || converted_cells[cell] == '_';
+        if(wall != previous_wall)
+        {
+            write_varint(converted_file, run_length);
+            run_length = 0;
+        }
+        run_length++;
+        previous_wall = wall;
+    }
+    write_varint(converted_file, run_length);
+
+    write_cell_list(converted_file, '_');
+    write_cell_list(converted_file, 'p');
+
+    if(fclose(converted_file) != 0)
+        status = FAILURE;
+
+    free(converted_cells);
+    converted_cells = NULL;
+
+    return status;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Reads an environment in the text format: the dimensions in the first line, followed by a line of symbols for each line of the environment.
+ *
+ * @param data Content of the file.
+ * @param size Number of bytes of the file.
+ * @param dimensions_handler Function called with the dimensions of the environment.
+ * @param symbol_handler Function called with the symbol and the coordinates of each cell.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_text_environment(const char *data, size_t size, Dimensions_Handler dimensions_handler, Symbol_Handler symbol_handler)
+{
+    const char *position = data, *end = data + size;
+    int lines, columns;
+
+    if(scan_dimension(&position, end, &lines) == false || scan_dimension(&position, end, &columns) == false)
+    {
+        fprintf(stderr, "Environment dimensions weren't found in the first line of the file.\n");
+        return FAILURE;
+    }
+
+    if(dimensions_handler(lines, columns) == FAILURE)
+        return FAILURE;
+
+    if(position < end)
+        position++; // Eliminates the '\n' after the environment dimensions.
+
+    for(int i = 0; i < lines; i++)
+    {
+        int h = 0;
+        for(; h <= columns; h++)
+        {
+            if(position == end)
+                break;
+
+            char read_char = *position++;
+
+            if(h == columns && read_char != '\n')
+            {
+                // The end of a line should have been reached
+                fprintf(stderr,"Line %d has more columns than the extracted column number.\n", i);
+                return FAILURE;
+            }
+
+            if(read_char == '\n')
+                break;
+
+            if( symbol_handler(read_char,(Location){i,h}) == FAILURE)
+                return FAILURE;
+        }
+
+        if( h < columns)
+        {
+            fprintf(stderr,"Line %d has less columns than the extracted column number.\n", i);
+            return FAILURE;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Reads an environment in the binary format described in environment_file.h.
+ *
+ * @param data Content of the file.
+ * @param size Number of bytes of the file.
+ * @param dimensions_handler Function called with the dimensions of the environment.
+ * @param symbol_handler Function called with the symbol and the coordinates of each cell.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_binary_environment(const char *data, size_t size, Dimensions_Handler dimensions_handler, Symbol_Handler symbol_handler)
+{
+    const char *position = data + strlen(ENVIRONMENT_MAGIC), *end = data + size;
+    unsigned int version, lines, columns, num_runs;
+
+    if(read_varint(&position, end, &version) == FAILURE || version != ENVIRONMENT_VERSION)
+    {
+        fprintf(stderr, "Unsupported version of the binary environment format.\n");
+        return FAILURE;
+    }
+
+    if(read_varint(&position, end, &lines) == FAILURE || read_varint(&position, end, &columns) == FAILURE || lines == 0 || columns == 0)
+    {
+        fprintf(stderr, "Environment dimensions weren't found in the binary environment file.\n");
+        return FAILURE;
+    }
+
+    if(dimensions_handler(lines, columns) == FAILURE)
+        return FAILURE;
+
+    long long num_cells = (long long) lines * columns, cell = 0;
+
+    if(read_varint(&position, end, &num_runs) == FAILURE)
+        return FAILURE;
+
+    for(unsigned int run = 0; run < num_runs; run++)
+    {
+        unsigned int run_length;
+        if(read_varint(&position, end, &run_length) == FAILURE || cell + run_length > num_cells)
+        {
+            fprintf(stderr, "The runs of the binary environment file don't match its dimensions.\n");
+            return FAILURE;
+        }
+
+        char symbol = run % 2 == 0 ? '.' : '#';
+        for(long long last_cell = cell + run_length; cell < last_cell; cell++)
+        {
+            if(symbol_handler(symbol, (Location){cell / columns, cell % columns}) == FAILURE)
+                return FAILURE;
+        }
+    }
+
+    if(cell != num_cells)
+    {
+        fprintf(stderr, "The runs of the binary environment file don't match its dimensions.\n");
+        return FAILURE;
+    }
+
+    if(read_cell_list(&position, end, num_cells, columns, '_', symbol_handler) == FAILURE ||
+       read_cell_list(&position, end, num_cells, columns, 'p', symbol_handler) == FAILURE)
+        return FAILURE;
+
+    return SUCCESS;
+}
+
+/**
+ * Reads a list of cells (exits or pedestrians) of a binary environment file.
+ *
+ * @param position Pointer to the current position of the file, which is advanced past the list.
+ * @param end End of the file.
+ * @param num_cells Number of cells of the environment.
+ * @param columns Number of columns of the environment.
+ * @param symbol Symbol handed for each cell of the list.
+ * @param symbol_handler Function called with the symbol and the coordinates of each cell.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_cell_list(const char **position, const char *end, long long num_cells, int columns, char symbol, Symbol_Handler symbol_handler)
+{
+    unsigned int num_list_cells, gap;
+    long long cell = 0;
+
+    if(read_varint(position, end, &num_list_cells) == FAILURE)
+        return FAILURE;
+
+    for(unsigned int list_index = 0; list_index < num_list_cells; list_index++)
+    {
+        if(read_varint(position, end, &gap) == FAILURE)
+            return FAILURE;
+
+        cell += gap;
+        if(cell >= num_cells)
+        {
+            fprintf(stderr, "A cell of the binary environment file is outside of the environment.\n");
+            return FAILURE;
+        }
+
+        if(symbol_handler(symbol, (Location){cell / columns, cell % columns}) == FAILURE)
+            return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Reads an unsigned LEB128 varint from the mapped environment file.
+ *
+ * @param position Pointer to the current position of the file, which is advanced past the varint.
+ * @param end End of the file.
+ * @param value Pointer to the integer where the read value will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_varint(const char **position, const char *end, unsigned int *value)
+{
+    unsigned int result = 0;
+
+    for(int shift = 0; shift < 35; shift += 7)
+    {
+        if(*position == end)
+        {
+            fprintf(stderr, "The binary environment file ended unexpectedly.\n");
+            return FAILURE;
+        }
+
+        unsigned char byte = *(*position)++;
+        result |= (unsigned int) (byte & 0x7F) << shift;
+
+        if((byte & 0x80) == 0)
+        {
+            *value = result;
+            return SUCCESS;
+        }
+    }
+
+    fprintf(stderr, "Invalid integer in the binary environment file.\n");
+    return FAILURE;
+}
+
+/**
+ * Reads a decimal integer (optionally preceded by whitespace and a sign) from the mapped environment file.
+ *
+ * @param position Pointer to the current position of the file, which is advanced past the integer.
+ * @param end End of the file.
+ * @param value Pointer to the integer where the read value will be stored.
+ * @return True, if an integer was read, or false, otherwise.
+*/
+static bool scan_dimension(const char **position, const char *end, int *value)
+{
+    const char *current = *position;
+    bool negative = false;
+    long long number = 0;
+
+    while(current < end && isspace((unsigned char) *current))
+        current++;
+
+    if(current < end && (*current == '-' || *current == '+'))
+    {
+        negative = *current == '-';
+        current++;
+    }
+
+    const char *first_digit = current;
+    while(current < end && isdigit((unsigned char) *current) && number <= INT_MAX)
+        number = number * 10 + (*current++ - '0');
+
+    if(current == first_digit || number > INT_MAX)
+        return false;
+
+    *value = negative ? (int) -number : (int) number;
+    *position = current;
+
+    return true;
+}
+
+/**
+ * Allocates the symbols of the environment being converted.
+ *
+ * @param lines Number of lines of the environment.
+ * @param columns Number of columns of the environment.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status store_converted_dimensions(int lines, int columns)
+{
+    if(lines <= 0 || columns <= 0)
+    {
+        fprintf(stderr, "The environment dimensions must be positive.\n");
+        return FAILURE;
+    }
+
+    converted_cells = malloc((size_t) lines * columns);
+    if(converted_cells == NULL)
+    {
+        fprintf(stderr,"Failure during allocation of the environment with dimensions: %d x %d.\n", lines, columns);
+        return FAILURE;
+    }
+
+    converted_lines = lines;
+    converted_columns = columns;
+
+    return SUCCESS;
+}
+
+/**
+ * Stores the symbol of a cell of the environment being converted.
+ *
+ * @param read_char The symbol of the cell.
+ * @param coordinates The coordinates of the cell.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status store_converted_symbol(char read_char, Location coordinates)
+{
+    if(read_char == 'P')
+        read_char = 'p';
+
+    if(read_char != '#' && read_char != '.' && read_char != '_' && read_char != 'p')
+    {
+        fprintf(stderr,"Unknow symbol in the environment file: %c.\n", read_char);
+        return FAILURE;
+    }
+
+    converted_cells[(long long) coordinates.lin * converted_columns + coordinates.col] = read_char;
+
+    return SUCCESS;
+}
+
+/**
+ * Writes the list of cells (exits or pedestrians) with the given symbol of the environment being converted.
+ *
+ * @param converted_file Stream where the list will be written.
+ * @param symbol Symbol of the cells of the list.
+*/
+static void write_cell_list(FILE *converted_file, char symbol)
+{
+    long long num_cells = (long long) converted_lines * converted_columns, previous_cell = 0;
+    unsigned int num_list_cells = 0;
+
+    for(long long cell = 0; cell < num_cells; cell++)
+    {
+        if(converted_cells[cell] == symbol)
+            num_list_cells++;
+    }
+
+    write_varint(converted_file, num_list_cells);
+
+    for(long long cell = 0; cell < num_cells; cell++)
+    {
+        if(converted_cells[cell] == symbol)
+        {
+            write_varint(converted_file, cell - previous_cell);
+            previous_cell = cell;
+        }
+    }
+}
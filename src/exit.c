@@ -8,24 +8,39 @@
 #include<stdio.h>
 #include<stdlib.h>
 #include<stdbool.h>
+#include<math.h>
 
 #include"../headers/exit.h"
 #include"../headers/grid.h"
 #include"../headers/cell.h"
 #include"../headers/pedestrian.h"
+#include"../headers/field_cache.h"
+#include"../headers/parallel_field.h"
+#include"../headers/tiled_field.h"
+#include"../headers/thread_pool.h"
 #include"../headers/cli_processing.h"
 #include"../headers/shared_resources.h"
 
-Exits_Set exits_set = {NULL, NULL, 0};
+#define TOLERANCE 1e-8
+
+Exits_Set exits_set = {NULL, NULL, 0, 0};
 
 static Exit create_new_exit(Location exit_coordinates);
 static Function_Status calculate_exit_floor_field(Exit s);
 static Function_Status calculate_static_weight(Exit current_exit);
 static Function_Status calculate_dynamic_weight(Exit current_exit);
+static double calculate_cell_dynamic_weight(Cell *occupied_cells, int num_occupied_cells, double static_weight, int exit_width);
+static Function_Status calculate_sparse_dynamic_weight(Exit current_exit, Cell *occupied_cells, int num_occupied_cells);
+static Function_Status calculate_sparse_exit_floor_field(Exit current_exit);
+static void merge_sparse_floor_fields();
 static void initialize_static_weight_grid(Exit current_exit);
 static void initialize_dynamic_weight_grid(Exit current_exit);
 static bool is_exit_accessible(Exit s);
 static int identify_occupied_cells(Cell **occupied_cells, Exit current_exit);
+static Function_Status run_exit_tasks(Pool_Task task, bool allow_concurrency);
+static Function_Status static_weight_task(int exit_index);
+static Function_Status dynamic_weight_task(int exit_index);
+static Function_Status exit_floor_field_task(int exit_index);
 
 /**
  * Adds a new exit to the exits set.
@@ -92,14 +107,11 @@ Function_Status calculate_all_static_weights()
         return FAILURE;
     }
 
-    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
-    {
-        Function_Status returned_status = calculate_static_weight(exits_set.list[exit_index]);
-        if(returned_status != SUCCESS )
-            return returned_status;
-    }
+    // In environments large enough for the parallel static weights, each exit already uses every thread.
+    bool is_field_parallel = cli_args.grid_layout == ROW_MAJOR_LAYOUT &&
+                             (long long) cli_args.global_line_number * cli_args.global_column_number >= cli_args.parallel_field_cells;
 
-    return SUCCESS;
+    return run_exit_tasks(static_weight_task, ! is_field_parallel);
 }
 
 /**
@@ -115,13 +127,7 @@ Function_Status calculate_all_dynamic_weights()
         return FAILURE;
     }
 
-    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
-    {
-        if(calculate_dynamic_weight(exits_set.list[exit_index]) == FAILURE)
-            return FAILURE;
-    }
-
-    return SUCCESS;
+    return run_exit_tasks(dynamic_weight_task, true);
 }
 
 /**
@@ -137,13 +143,7 @@ Function_Status calculate_all_exits_floor_field()
         return FAILURE;
     }
 
-    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
-    {
-        if(calculate_exit_floor_field(exits_set.list[exit_index]) == FAILURE)
-            return FAILURE;
-    }
-
-    return SUCCESS;
+    return run_exit_tasks(exit_floor_field_task, true);
 }
 
 
@@ -161,6 +161,8 @@ Function_Status allocate_final_floor_field()
         return FAILURE;
     }
 
+    exits_set.final_floor_field_version++;
+
     return SUCCESS;
 }
 
@@ -181,6 +183,14 @@ Function_Status calculate_final_floor_field()
     if( reset_double_grid(exits_set.final_floor_field, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
         return FAILURE;
 
+    if(cli_args.grid_layout == SPARSE_LAYOUT)
+    {
+        merge_sparse_floor_fields();
+        exits_set.final_floor_field_version++;
+
+        return SUCCESS;
+    }
+
     Double_Grid current_exit = exits_set.list[0]->floor_field;
     copy_double_grid(exits_set.final_floor_field, current_exit); // uses the first exit as the base for the merging
     
@@ -197,9 +207,46 @@ Function_Status calculate_final_floor_field()
         }
     }
 
+    exits_set.final_floor_field_version++;
+
     return SUCCESS;
 }
 
+/**
+ * Calculates the value of delta (static delta or first timestep delta).
+ * Delta is a value between 0 and 1 (inclusive) that indicates the distribution of pedestrians between two exits in an environment. Values close to 0 indicate a balanced preference between both doors, while values close to 1 indicate a strong preference of pedestrians for one exit over the other.
+ * 
+ * @return The calculated delta, as a double.
+*/
+double calculate_distribution_delta()
+{
+    if(exits_set.num_exits != 2)
+        return 1; // The delta is calculated only for situations where the environments has two exits.
+                  // All other cases, with a single exit in particular, will receive a value of 1.
+
+    // Alpha == 0 indicates that the static delta is required.
+    Exit exit_A = exits_set.list[0];
+    Exit exit_B = exits_set.list[1];
+
+    int N_A = 0; // The number of cells where the floor field of exit_A is greater or equal to the floor field of exit_B. 
+    for(int i = 0; i < cli_args.global_line_number; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+        {
+            double value_A = cli_args.alpha == 0 ? EXIT_GRID_CELL(exit_A, static_weight, i, h) : EXIT_GRID_CELL(exit_A, floor_field, i, h);
+            double value_B = cli_args.alpha == 0 ? EXIT_GRID_CELL(exit_B, static_weight, i, h) : EXIT_GRID_CELL(exit_B, floor_field, i, h);
+
+            if(value_A == WALL_VALUE || value_A == EXIT_VALUE || value_B == EXIT_VALUE)
+                continue;
+
+            if(pedestrian_position_grid[i][h] != 0 && value_B <= value_A + TOLERANCE)
+                N_A++;
+        }
+    }
+
+    return 1.0 - (fmin(N_A, pedestrian_set.num_pedestrians - N_A) / fmax(N_A, pedestrian_set.num_pedestrians - N_A));
+}
+
 /**
  * Deallocate and reset the structures related to each exit and the exists set.
 */
@@ -213,6 +260,9 @@ void deallocate_exits()
         deallocate_grid((void **) current->floor_field, cli_args.global_line_number);
         deallocate_grid((void **) current->static_weight, cli_args.global_line_number);
         deallocate_grid((void **) current->dynamic_weight, cli_args.global_line_number);
+        deallocate_sparse_grid(current->sparse_floor_field);
+        deallocate_sparse_grid(current->sparse_static_weight);
+        deallocate_sparse_grid(current->sparse_dynamic_weight);
         free(current);
     }
 
@@ -249,9 +299,25 @@ static Exit create_new_exit(Location exit_coordinates)
             new_exit->coordinates[0] = exit_coordinates;
             new_exit->width = 1;
 
-            new_exit->floor_field = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
-            new_exit->static_weight = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
-            new_exit->dynamic_weight = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
+            new_exit->floor_field = NULL;
+            new_exit->static_weight = NULL;
+            new_exit->dynamic_weight = NULL;
+            new_exit->sparse_floor_field = NULL;
+            new_exit->sparse_static_weight = NULL;
+            new_exit->sparse_dynamic_weight = NULL;
+
+            if(cli_args.grid_layout == SPARSE_LAYOUT)
+            {
+                new_exit->sparse_floor_field = allocate_sparse_grid(cli_args.global_line_number, cli_args.global_column_number);
+                new_exit->sparse_static_weight = allocate_sparse_grid(cli_args.global_line_number, cli_args.global_column_number);
+                new_exit->sparse_dynamic_weight = allocate_sparse_grid(cli_args.global_line_number, cli_args.global_column_number);
+            }
+            else
+            {
+                new_exit->floor_field = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
+                new_exit->static_weight = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
+                new_exit->dynamic_weight = allocate_double_grid(cli_args.global_line_number, cli_args.global_column_number);
+            }
         }
 
         return new_exit;
@@ -274,11 +340,21 @@ static Function_Status calculate_static_weight(Exit current_exit)
              {       1.0,           0.0,           1.0       },
              {cli_args.diagonal,    1.0,    cli_args.diagonal}};
 
-    initialize_static_weight_grid(current_exit);
+    if(current_exit->static_weight != NULL)
+        initialize_static_weight_grid(current_exit); // The sparse static weights are initialized by calculate_tiled_static_weight.
 
     if(is_exit_accessible(current_exit) == false)
         return INACCESSIBLE_EXIT;
 
+    if(cli_args.static_field_cache && current_exit->width == 1)
+        return load_cached_static_weight(current_exit);
+
+    if(cli_args.grid_layout != ROW_MAJOR_LAYOUT)
+        return calculate_tiled_static_weight(current_exit);
+
+    if(cli_args.num_threads > 1 && (long long) cli_args.global_line_number * cli_args.global_column_number >= cli_args.parallel_field_cells)
+        return calculate_parallel_static_weight(current_exit);
+
     Double_Grid static_weight = current_exit->static_weight;
     Double_Grid auxiliary_grid = allocate_double_grid(cli_args.global_line_number,cli_args.global_column_number);
     // stores the chances for the timestep t + 1
@@ -366,6 +442,14 @@ static Function_Status calculate_dynamic_weight(Exit current_exit)
         return FAILURE;
     
     quick_sort(occupied_cells, 0, num_occupied_cells - 1);
+
+    if(current_exit->sparse_dynamic_weight != NULL)
+    {
+        Function_Status status = calculate_sparse_dynamic_weight(current_exit, occupied_cells, num_occupied_cells);
+        free(occupied_cells);
+
+        return status;
+    }
     
     initialize_dynamic_weight_grid(current_exit);
     Double_Grid dynamic_weight = current_exit->dynamic_weight;
@@ -377,18 +461,7 @@ static Function_Status calculate_dynamic_weight(Exit current_exit)
             if(dynamic_weight[i][h] == -1)
                 continue;
 
-            double static_weight = current_exit->static_weight[i][h];
-
-            int num_cells_equal_value = 0;
-            int num_cells_smaller_value = count_cells_with_smaller_value(occupied_cells, num_occupied_cells, 
-                                                                         static_weight, &num_cells_equal_value);
-
-            if(num_cells_smaller_value == -1)
-                num_cells_smaller_value = 0; // Not a single cell smaller than the current static_weight.
-            
-
-
-            dynamic_weight[i][h] = (num_cells_smaller_value + num_cells_equal_value) / (double) current_exit->width;
+            dynamic_weight[i][h] = calculate_cell_dynamic_weight(occupied_cells, num_occupied_cells, current_exit->static_weight[i][h], current_exit->width);
         }
     }
 
@@ -413,6 +486,9 @@ static Function_Status calculate_exit_floor_field(Exit current_exit)
         return FAILURE;
     }
 
+    if(current_exit->sparse_floor_field != NULL)
+        return calculate_sparse_exit_floor_field(current_exit);
+
     for(int i = 0; i < cli_args.global_line_number; i++)
     {
         for(int h = 0; h < cli_args.global_column_number; h++)
@@ -428,6 +504,125 @@ static Function_Status calculate_exit_floor_field(Exit current_exit)
     return SUCCESS;
 }
 
+/**
+ * Calculates the dynamic weight of a cell with the given static weight.
+ *
+ * @param occupied_cells Cells occupied by pedestrians, with their static weights, sorted by the static weights.
+ * @param num_occupied_cells Number of occupied cells.
+ * @param static_weight Static weight of the cell.
+ * @param exit_width Width of the exit.
+ * @return The dynamic weight.
+*/
+static double calculate_cell_dynamic_weight(Cell *occupied_cells, int num_occupied_cells, double static_weight, int exit_width)
+{
+    int num_cells_equal_value = 0;
+    int num_cells_smaller_value = count_cells_with_smaller_value(occupied_cells, num_occupied_cells, 
+                                                                 static_weight, &num_cells_equal_value);
+
+    if(num_cells_smaller_value == -1)
+        num_cells_smaller_value = 0; // Not a single cell smaller than the current static_weight.
+
+    return (num_cells_smaller_value + num_cells_equal_value) / (double) exit_width;
+}
+
+/**
+ * Calculates the sparse dynamic weights for the given exit, in the tiles where its static weights were materialized. The other cells, unreachable from the exit, share the dynamic weight of a static weight of zero.
+ *
+ * @param current_exit Exit for which the dynamic weights will be calculated.
+ * @param occupied_cells Cells occupied by pedestrians, with their static weights, sorted by the static weights.
+ * @param num_occupied_cells Number of occupied cells.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status calculate_sparse_dynamic_weight(Exit current_exit, Cell *occupied_cells, int num_occupied_cells)
+{
+    Sparse_Grid *static_weight = current_exit->sparse_static_weight;
+    Sparse_Grid *dynamic_weight = current_exit->sparse_dynamic_weight;
+
+    dynamic_weight->wall_value = -1; // Cells with no dynamic weight (obstacles and walls).
+    dynamic_weight->background_value = calculate_cell_dynamic_weight(occupied_cells, num_occupied_cells, static_weight->background_value, current_exit->width);
+
+    for(int tile_index = 0; tile_index < static_weight->num_tiles; tile_index++)
+    {
+        if(static_weight->tiles[tile_index] == NULL)
+            continue;
+
+        double *tile = materialize_sparse_tile(dynamic_weight, tile_index);
+        if(tile == NULL)
+            return FAILURE;
+
+        int first_line = tile_index / static_weight->tile_columns * TILE_SIDE, first_column = tile_index % static_weight->tile_columns * TILE_SIDE;
+        for(int j = 0; j < TILE_SIDE && first_line + j < cli_args.global_line_number; j++)
+        {
+            for(int k = 0; k < TILE_SIDE && first_column + k < cli_args.global_column_number; k++)
+            {
+                if(environment_only_grid[first_line + j][first_column + k] == WALL_VALUE)
+                    tile[j * TILE_SIDE + k] = -1;
+                else
+                    tile[j * TILE_SIDE + k] = calculate_cell_dynamic_weight(occupied_cells, num_occupied_cells, static_weight->tiles[tile_index][j * TILE_SIDE + k], current_exit->width);
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Combines the sparse static and dynamic weights into the sparse floor field for the given exit, as calculate_exit_floor_field.
+ *
+ * @param current_exit Exit for which the floor field will be calculated.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status calculate_sparse_exit_floor_field(Exit current_exit)
+{
+    Sparse_Grid *static_weight = current_exit->sparse_static_weight;
+    Sparse_Grid *dynamic_weight = current_exit->sparse_dynamic_weight;
+    Sparse_Grid *floor_field = current_exit->sparse_floor_field;
+
+    floor_field->wall_value = static_weight->wall_value;
+    floor_field->background_value = static_weight->background_value + cli_args.alpha * dynamic_weight->background_value;
+
+    for(int tile_index = 0; tile_index < static_weight->num_tiles; tile_index++)
+    {
+        if(static_weight->tiles[tile_index] == NULL)
+            continue;
+
+        double *tile = materialize_sparse_tile(floor_field, tile_index);
+        if(tile == NULL)
+            return FAILURE;
+
+        for(int cell_index = 0; cell_index < TILE_SIDE * TILE_SIDE; cell_index++)
+        {
+            if(dynamic_weight->tiles[tile_index][cell_index] == -1)
+                tile[cell_index] = static_weight->tiles[tile_index][cell_index];
+            else
+                tile[cell_index] = static_weight->tiles[tile_index][cell_index] + cli_args.alpha * dynamic_weight->tiles[tile_index][cell_index];
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Stores in the final floor field the lowest value of the sparse floor fields of the exits for each cell, as calculate_final_floor_field.
+*/
+static void merge_sparse_floor_fields()
+{
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Sparse_Grid *floor_field = exits_set.list[exit_index]->sparse_floor_field;
+
+        for(int i = 0; i < cli_args.global_line_number; i++)
+        {
+            for(int h = 0; h < cli_args.global_column_number; h++)
+            {
+                double cell_value = get_sparse_cell(floor_field, i, h);
+                if(exit_index == 0 || exits_set.final_floor_field[i][h] > cell_value)
+                    exits_set.final_floor_field[i][h] = cell_value;
+            }
+        }
+    }
+}
+
 /**
  * Copies the structure (obstacles and walls) from the environment_only_grid to the static weight grid 
  * for the provided exit. Additionally, adds the exit cells to it.
@@ -505,7 +700,8 @@ static bool is_exit_accessible(Exit current_exit)
                 if(! is_within_grid_columns(c.col + k))
                     continue;
 
-                if(current_exit->floor_field[c.lin + j][c.col + k] == WALL_VALUE || current_exit->floor_field[c.lin + j][c.col + k] == EXIT_VALUE)
+                double cell_value = EXIT_GRID_CELL(current_exit, floor_field, c.lin + j, c.col + k);
+                if(cell_value == WALL_VALUE || cell_value == EXIT_VALUE)
                     continue;
 
                 if(j != 0 && k != 0)
@@ -546,10 +742,79 @@ static int identify_occupied_cells(Cell **occupied_cells, Exit current_exit)
         Location pedestrian_location = pedestrian_set.list[p_index]->current;
 
         (*occupied_cells)[num_occupied_cells].coordinates = pedestrian_location;
-        (*occupied_cells)[num_occupied_cells].value = current_exit->static_weight[pedestrian_location.lin][pedestrian_location.col];
+        (*occupied_cells)[num_occupied_cells].value = EXIT_GRID_CELL(current_exit, static_weight, pedestrian_location.lin, pedestrian_location.col);
 
         num_occupied_cells++;
     }
 
     return num_occupied_cells;
-}
\ No newline at end of file
+}
+
+/**
+ * Runs a task for every exit in the exits_set, stopping at the first one that doesn't succeed. In environments with at least cli_args.parallel_exit_cells cells, the tasks run concurrently on the thread pool; all of them run, and the status of the first one (in the exits order) that didn't succeed is returned, as if they had run sequentially.
+ *
+ * @param task Function called with the index of each exit.
+ * @param allow_concurrency Indicates if the tasks may run concurrently.
+ * @return Function_Status: the status of the first task that didn't succeed, or SUCCESS (1).
+*/
+static Function_Status run_exit_tasks(Pool_Task task, bool allow_concurrency)
+{
+    bool is_concurrent = allow_concurrency && cli_args.num_threads > 1 && exits_set.num_exits > 1 &&
+                         (long long) cli_args.global_line_number * cli_args.global_column_number >= cli_args.parallel_exit_cells;
+
+    if(! is_concurrent)
+    {
+        for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+        {
+            Function_Status returned_status = task(exit_index);
+            if(returned_status != SUCCESS)
+                return returned_status;
+        }
+
+        return SUCCESS;
+    }
+
+    Function_Status task_statuses[exits_set.num_exits];
+    run_pool_tasks(task, exits_set.num_exits, task_statuses);
+
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        if(task_statuses[exit_index] != SUCCESS)
+            return task_statuses[exit_index];
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Pool task that calculates the static weights of an exit.
+ *
+ * @param exit_index Index of the exit in the exits_set.
+ * @return Function_Status: FAILURE (0), SUCCESS (1) or INACCESSIBLE_EXIT(2).
+*/
+static Function_Status static_weight_task(int exit_index)
+{
+    return calculate_static_weight(exits_set.list[exit_index]);
+}
+
+/**
+ * Pool task that calculates the dynamic weights of an exit.
+ *
+ * @param exit_index Index of the exit in the exits_set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status dynamic_weight_task(int exit_index)
+{
+    return calculate_dynamic_weight(exits_set.list[exit_index]);
+}
+
+/**
+ * Pool task that calculates the floor field of an exit.
+ *
+ * @param exit_index Index of the exit in the exits_set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status exit_floor_field_task(int exit_index)
+{
+    return calculate_exit_floor_field(exits_set.list[exit_index]);
+}
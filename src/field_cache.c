@@ -0,0 +1,276 @@
+/*
+   File: field_cache.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module keeps the static weights of single-cell exits (the per-door field cache), which are reused by every simulation set that places an exit in the same cell. On its first use, the static weights of every border cell that may hold an exit are calculated in batches of FIELD_BATCH_SIZE cells, with a single pass over the grid for all the exit cells of a batch. Each lane of the batch follows exactly the same steps as calculate_static_weight, so the results are identical.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<pthread.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/field_cache.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+typedef double Field_Vector __attribute__((vector_size(FIELD_BATCH_SIZE * sizeof(double))));
+typedef long long Mask_Vector __attribute__((vector_size(FIELD_BATCH_SIZE * sizeof(long long))));
+
+// Selects, for each lane, the value of if_true where the mask is set and the value of if_false elsewhere.
+#define SELECT_VECTOR(mask, if_true, if_false) ((Field_Vector) (((mask) & (Mask_Vector) (if_true)) | (~(mask) & (Mask_Vector) (if_false))))
+
+static Double_Grid *cached_static_weights = NULL; // Static weights of the exit placed in each cell, indexed by line * columns + column (NULL if not calculated).
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER; // The exits may be calculated concurrently by the thread pool.
+
+static Function_Status fill_border_cache();
+static Function_Status calculate_static_weight_batch(Location *exit_cells, int num_exit_cells);
+static bool is_mask_empty(const Mask_Vector *mask);
+
+/**
+ * Copies the static weights of a single-cell exit from the cache, calculating them (along with those of every border cell, on the first call) when necessary.
+ *
+ * @param current_exit Single-cell exit whose static weights will be loaded.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_cached_static_weight(Exit current_exit)
+{
+    Location exit_cell = current_exit->coordinates[0];
+    int cell_index = exit_cell.lin * cli_args.global_column_number + exit_cell.col;
+
+    pthread_mutex_lock(&cache_lock);
+
+    Function_Status status = SUCCESS;
+    if(cached_static_weights == NULL)
+        status = fill_border_cache();
+
+    if(status == SUCCESS && cached_static_weights[cell_index] == NULL)
+        status = calculate_static_weight_batch(&exit_cell, 1);
+
+    pthread_mutex_unlock(&cache_lock);
+
+    if(status == FAILURE)
+        return FAILURE;
+
+    // Cached grids are never changed or removed while the simulations run.
+    return copy_double_grid(current_exit->static_weight, cached_static_weights[cell_index]);
+}
+
+/**
+ * Deallocates the static weights stored in the cache.
+*/
+void deallocate_field_cache()
+{
+    if(cached_static_weights == NULL)
+        return;
+
+    int num_cells = cli_args.global_line_number * cli_args.global_column_number;
+    for(int cell_index = 0; cell_index < num_cells; cell_index++)
+        deallocate_grid((void **) cached_static_weights[cell_index], cli_args.global_line_number);
+
+    free(cached_static_weights);
+    cached_static_weights = NULL;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Allocates the cache and calculates the static weights of every border cell that is a wall with a non-diagonal neighbor that isn't a wall (the cells that may hold an accessible exit).
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status fill_border_cache()
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    cached_static_weights = calloc((size_t) lines * columns, sizeof(Double_Grid));
+    if(cached_static_weights == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the static field cache.\n");
+        return FAILURE;
+    }
+
+    Location batch[FIELD_BATCH_SIZE];
+    int batch_size = 0;
+
+    for(int i = 0; i < lines; i++)
+    {
+        for(int h = 0; h < columns; h++)
+        {
+            if((i != 0 && i != lines - 1 && h != 0 && h != columns - 1) || environment_only_grid[i][h] != WALL_VALUE)
+                continue;
+
+            bool has_open_neighbor = (i > 0 && environment_only_grid[i - 1][h] != WALL_VALUE) ||
+                                     (i < lines - 1 && environment_only_grid[i + 1][h] != WALL_VALUE) ||
+                                     (h > 0 && environment_only_grid[i][h - 1] != WALL_VALUE) ||
+                                     (h < columns - 1 && environment_only_grid[i][h + 1] != WALL_VALUE);
+            if(has_open_neighbor == false)
+                continue;
+
+            batch[batch_size++] = (Location) {i, h};
+            if(batch_size == FIELD_BATCH_SIZE)
+            {
+                if(calculate_static_weight_batch(batch, batch_size) == FAILURE)
+                    return FAILURE;
+                batch_size = 0;
+            }
+        }
+    }
+
+    if(batch_size > 0)
+        return calculate_static_weight_batch(batch, batch_size);
+
+    return SUCCESS;
+}
+
+/**
+ * Calculates the static weights of up to FIELD_BATCH_SIZE single-cell exits at once, storing them in the cache. Each lane holds the static weight grid of one exit cell and is updated with the same rules (and the same sweeps) as in calculate_static_weight.
+ *
+ * @param exit_cells Cells of the exits.
+ * @param num_exit_cells Number of exit cells, between 1 and FIELD_BATCH_SIZE.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status calculate_static_weight_batch(Location *exit_cells, int num_exit_cells)
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+    size_t num_cells = (size_t) lines * columns;
+
+    Field_Vector *static_weight = aligned_alloc(sizeof(Field_Vector), sizeof(Field_Vector) * num_cells);
+    Field_Vector *auxiliary_grid = aligned_alloc(sizeof(Field_Vector), sizeof(Field_Vector) * num_cells);
+    if(static_weight == NULL || auxiliary_grid == NULL)
+    {
+        fprintf(stderr, "Failure to allocate the grids at calculate_static_weight_batch.\n");
+        free(static_weight);
+        free(auxiliary_grid);
+        return FAILURE;
+    }
+
+    // Same structure as initialize_static_weight_grid; lanes without an exit cell have nothing to propagate.
+    for(int i = 0; i < lines; i++)
+    {
+        for(int h = 0; h < columns; h++)
+        {
+            double cell_value = environment_only_grid[i][h] == WALL_VALUE ? WALL_VALUE : 0.0;
+            for(int lane = 0; lane < FIELD_BATCH_SIZE; lane++)
+                static_weight[i * columns + h][lane] = cell_value;
+        }
+    }
+
+    for(int lane = 0; lane < num_exit_cells; lane++)
+        static_weight[exit_cells[lane].lin * columns + exit_cells[lane].col][lane] = EXIT_VALUE;
+
+    memcpy(auxiliary_grid, static_weight, sizeof(Field_Vector) * num_cells);
+
+    double floor_field_rule[][3] =
+            {{cli_args.diagonal,    1.0,    cli_args.diagonal},
+             {       1.0,           0.0,           1.0       },
+             {cli_args.diagonal,    1.0,    cli_args.diagonal}};
+
+    Field_Vector wall_vector, exit_vector, zero_vector;
+    for(int lane = 0; lane < FIELD_BATCH_SIZE; lane++)
+    {
+        wall_vector[lane] = WALL_VALUE;
+        exit_vector[lane] = EXIT_VALUE;
+        zero_vector[lane] = 0.0;
+    }
+
+    Mask_Vector has_changed;
+    do
+    {
+        has_changed = (Mask_Vector) {0};
+        for(int i = 0; i < lines; i++)
+        {
+            for(int h = 0; h < columns; h++)
+            {
+                Field_Vector current_cell_value = static_weight[i * columns + h];
+
+                // floor field calculations occur only on cells with values
+                Mask_Vector has_value = (current_cell_value != wall_vector) & (current_cell_value != zero_vector);
+                if(is_mask_empty(&has_value))
+                    continue;
+
+                for(int j = -1; j < 2; j++)
+                {
+                    if(! is_within_grid_lines(i + j))
+                        continue;
+
+                    for(int k = -1; k < 2; k++)
+                    {
+                        if(! is_within_grid_columns(h + k) || (j == 0 && k == 0)) // A cell never lowers its own value.
+                            continue;
+
+                        Field_Vector adjacent_weight = static_weight[(i + j) * columns + h + k];
+                        Mask_Vector can_update = has_value & (adjacent_weight != wall_vector) & (adjacent_weight != exit_vector);
+
+                        if(j != 0 && k != 0)
+                        {
+                            // Same rules as is_diagonal_valid.
+                            Mask_Vector is_vertical_blocked = static_weight[(i + j) * columns + h] == wall_vector;
+                            Mask_Vector is_horizontal_blocked = static_weight[i * columns + h + k] == wall_vector;
+
+                            can_update &= ~(is_vertical_blocked & is_horizontal_blocked);
+                            if(cli_args.prevent_corner_crossing)
+                                can_update &= ~(is_vertical_blocked | is_horizontal_blocked);
+                        }
+
+                        if(is_mask_empty(&can_update))
+                            continue;
+
+                        Field_Vector adjacent_cell_value = current_cell_value + floor_field_rule[1 + j][1 + k];
+                        Field_Vector auxiliary_value = auxiliary_grid[(i + j) * columns + h + k];
+                        Mask_Vector is_lower = can_update & ((auxiliary_value == zero_vector) | (adjacent_cell_value < auxiliary_value));
+
+                        auxiliary_grid[(i + j) * columns + h + k] = SELECT_VECTOR(is_lower, adjacent_cell_value, auxiliary_value);
+                        has_changed |= is_lower;
+                    }
+                }
+            }
+        }
+        memcpy(static_weight, auxiliary_grid, sizeof(Field_Vector) * num_cells);
+        // make sure static_weight now holds t + 1 timestep, allowing auxiliary_grid to hold t + 2 timestep.
+    }
+    while(! is_mask_empty(&has_changed));
+
+    Function_Status status = SUCCESS;
+    for(int lane = 0; lane < num_exit_cells; lane++)
+    {
+        Double_Grid lane_grid = allocate_double_grid(lines, columns);
+        if(lane_grid == NULL)
+        {
+            status = FAILURE;
+            break;
+        }
+
+        for(int i = 0; i < lines; i++)
+        {
+            for(int h = 0; h < columns; h++)
+                lane_grid[i][h] = static_weight[i * columns + h][lane];
+        }
+
+        cached_static_weights[exit_cells[lane].lin * columns + exit_cells[lane].col] = lane_grid;
+    }
+
+    free(static_weight);
+    free(auxiliary_grid);
+
+    return status;
+}
+
+/**
+ * Verifies if no lane of the mask is set.
+ *
+ * @param mask Pointer to the mask to be verified.
+ * @return bool, where True indicates an empty mask.
+*/
+static bool is_mask_empty(const Mask_Vector *mask)
+{
+    long long any = 0;
+    for(int lane = 0; lane < FIELD_BATCH_SIZE; lane++)
+        any |= (*mask)[lane];
+
+    return any == 0;
+}
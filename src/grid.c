@@ -95,6 +95,93 @@ Double_Grid allocate_double_grid(int line_number, int column_number)
     return new_grid;
 }
 
+/**
+ * Dynamically allocates a double matrix in tiles of TILE_SIDE x TILE_SIDE cells, covering at least the dimensions determined by the function parameters.
+ *
+ * @param line_number Number of lines of the grid.
+ * @param column_number Number of columns of the grid.
+ * @return A Tiled_Grid, whose cells are NULL on error.
+ *
+ * @note All positions of the matrix, including the ones that complete the last tiles, are already zeroed.
+ */
+Tiled_Grid allocate_tiled_grid(int line_number, int column_number)
+{
+    Tiled_Grid new_grid = {NULL, 0};
+
+    if(line_number <= 0 || column_number <= 0)
+    {
+        fprintf(stderr, "At least one of the grid dimensions was negative or zero.\n");
+        return new_grid;
+    }
+
+    int tile_lines = (line_number + TILE_SIDE - 1) / TILE_SIDE;
+    new_grid.tile_columns = (column_number + TILE_SIDE - 1) / TILE_SIDE;
+
+    new_grid.cells = calloc((size_t) tile_lines * new_grid.tile_columns * TILE_SIDE * TILE_SIDE, sizeof(double));
+    if(new_grid.cells == NULL)
+        fprintf(stderr, "Failed to allocate memory for the tiles of a tiled grid.\n");
+
+    return new_grid;
+}
+
+/**
+ * Dynamically allocates a sparse double matrix, in tiles of TILE_SIDE x TILE_SIDE cells covering the dimensions determined by the function parameters. No tile is materialized, and the wall and background values are zero.
+ *
+ * @param line_number Number of lines of the grid.
+ * @param column_number Number of columns of the grid.
+ * @return A NULL pointer, on error, or a Sparse_Grid if the grid was successfully allocated.
+ */
+Sparse_Grid *allocate_sparse_grid(int line_number, int column_number)
+{
+    if(line_number <= 0 || column_number <= 0)
+    {
+        fprintf(stderr, "At least one of the grid dimensions was negative or zero.\n");
+        return NULL;
+    }
+
+    Sparse_Grid *new_grid = calloc(1, sizeof(Sparse_Grid));
+    if(new_grid == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for a sparse grid.\n");
+        return NULL;
+    }
+
+    new_grid->tile_columns = (column_number + TILE_SIDE - 1) / TILE_SIDE;
+    new_grid->num_tiles = (line_number + TILE_SIDE - 1) / TILE_SIDE * new_grid->tile_columns;
+
+    new_grid->tiles = calloc(new_grid->num_tiles, sizeof(double *));
+    if(new_grid->tiles == NULL)
+    {
+        free(new_grid);
+
+        fprintf(stderr, "Failed to allocate memory for the tiles of a sparse grid.\n");
+        return NULL;
+    }
+
+    return new_grid;
+}
+
+/**
+ * Allocates the given tile of a sparse grid, if it wasn't materialized yet.
+ *
+ * @param grid The Sparse_Grid.
+ * @param tile_index Index of the tile, in row-major order.
+ * @return A NULL pointer, on error, or the TILE_SIDE x TILE_SIDE cells of the tile, in row-major order.
+ *
+ * @note The cells of a new tile are zeroed.
+ */
+double *materialize_sparse_tile(Sparse_Grid *grid, int tile_index)
+{
+    if(grid->tiles[tile_index] == NULL)
+    {
+        grid->tiles[tile_index] = calloc(TILE_SIDE * TILE_SIDE, sizeof(double));
+        if(grid->tiles[tile_index] == NULL)
+            fprintf(stderr, "Failed to allocate memory for the tile %d of a sparse grid.\n", tile_index);
+    }
+
+    return grid->tiles[tile_index];
+}
+
 /**
  * Reset all positions of an integer grid to zero.
  *
@@ -270,4 +357,32 @@ void deallocate_grid(void **grid, int line_number)
 
         grid = NULL;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Deallocate all memory assigned to a tiled grid.
+ *
+ * @param grid The Tiled_Grid to be deallocated.
+ */
+void deallocate_tiled_grid(Tiled_Grid *grid)
+{
+    free(grid->cells);
+    grid->cells = NULL;
+}
+
+/**
+ * Deallocate all memory assigned to a sparse grid, including its materialized tiles.
+ *
+ * @param grid The Sparse_Grid to be deallocated (may be NULL).
+ */
+void deallocate_sparse_grid(Sparse_Grid *grid)
+{
+    if(grid == NULL)
+        return;
+
+    for(int tile_index = 0; tile_index < grid->num_tiles; tile_index++)
+        free(grid->tiles[tile_index]);
+
+    free(grid->tiles);
+    free(grid);
+}
@@ -0,0 +1,176 @@
+/*
+   File: heatmap.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module accumulates the pedestrian visits per cell. Each worker increments its own grid, and the grids are summed into heatmap_grid, always in the order of the worker indexes, at the end of each simulation set. It also writes the binary heatmap format, described in heatmap.h.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+
+#include"../headers/grid.h"
+#include"../headers/heatmap.h"
+#include"../headers/trajectory.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static Int_Grid *worker_heatmaps = NULL; // Visit counts of each worker since the last reduction.
+static int num_heatmap_workers = 0;
+static _Thread_local int heatmap_worker = 0; // Index of the accumulator used by the calling thread.
+
+/**
+ * Allocates a zeroed heatmap accumulator for each worker.
+ *
+ * @param num_workers Number of workers that can record visits concurrently.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status allocate_heatmap_accumulators(int num_workers)
+{
+    worker_heatmaps = calloc(num_workers, sizeof(Int_Grid));
+    if(worker_heatmaps == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the heatmap accumulators.\n");
+        return FAILURE;
+    }
+
+    num_heatmap_workers = num_workers;
+    for(int worker_index = 0; worker_index < num_workers; worker_index++)
+    {
+        worker_heatmaps[worker_index] = allocate_integer_grid(cli_args.global_line_number, cli_args.global_column_number);
+        if(worker_heatmaps[worker_index] == NULL)
+        {
+            fprintf(stderr, "Failure during the allocation of the heatmap accumulators with dimensions: %d x %d.\n", cli_args.global_line_number, cli_args.global_column_number);
+            return FAILURE;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Selects the accumulator in which the visits recorded by the calling thread will be stored.
+ *
+ * @param worker_index Index of the worker, between 0 and the number of workers - 1.
+*/
+void set_heatmap_worker(int worker_index)
+{
+    heatmap_worker = worker_index;
+}
+
+/**
+ * Records a visit to the given cell in the accumulator of the calling thread.
+ *
+ * @note Has no effect when the accumulators weren't allocated (output formats other than the heatmap).
+ *
+ * @param cell Location of the visited cell.
+*/
+void record_heatmap_visit(Location cell)
+{
+    if(worker_heatmaps == NULL)
+        return;
+
+    worker_heatmaps[heatmap_worker][cell.lin][cell.col]++;
+}
+
+/**
+ * Adds the visits of every worker to heatmap_grid, in the order of the worker indexes, and resets the accumulators.
+*/
+void reduce_heatmap_accumulators()
+{
+    for(int worker_index = 0; worker_index < num_heatmap_workers; worker_index++)
+    {
+        Int_Grid worker_heatmap = worker_heatmaps[worker_index];
+
+        for(int i = 0; i < cli_args.global_line_number; i++)
+        {
+            for(int h = 0; h < cli_args.global_column_number; h++)
+                heatmap_grid[i][h] += worker_heatmap[i][h];
+        }
+
+        reset_integer_grid(worker_heatmap, cli_args.global_line_number, cli_args.global_column_number);
+    }
+}
+
+/**
+ * Writes the header of the binary heatmap format (magic, version and dimensions).
+ *
+ * @param output_stream Stream where the data will be written.
+*/
+void write_binary_heatmap_header(FILE *output_stream)
+{
+    fwrite(HEATMAP_MAGIC, 1, sizeof(HEATMAP_MAGIC) - 1, output_stream);
+    write_varint(output_stream, HEATMAP_VERSION);
+    write_varint(output_stream, cli_args.global_line_number);
+    write_varint(output_stream, cli_args.global_column_number);
+}
+
+/**
+ * Writes heatmap_grid as a binary record containing only the runs of cells with nonzero visit counts.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param num_simulations Number of simulations accumulated in heatmap_grid (0 for simulation sets with inaccessible exits).
+*/
+void write_binary_heatmap(FILE *output_stream, int num_simulations)
+{
+    int num_runs = 0;
+    for(int i = 0; i < cli_args.global_line_number && num_simulations > 0; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+        {
+            if(heatmap_grid[i][h] != 0 && (h == 0 || heatmap_grid[i][h - 1] == 0))
+                num_runs++;
+        }
+    }
+
+    fputc(HEATMAP_SET, output_stream);
+    write_varint(output_stream, num_simulations);
+    write_varint(output_stream, num_runs);
+
+    for(int i = 0; i < cli_args.global_line_number && num_runs > 0; i++)
+    {
+        int h = 0;
+        while(h < cli_args.global_column_number)
+        {
+            if(heatmap_grid[i][h] == 0)
+            {
+                h++;
+                continue;
+            }
+
+            int run_length = 0;
+            while(h + run_length < cli_args.global_column_number && heatmap_grid[i][h + run_length] != 0)
+                run_length++;
+
+            write_varint(output_stream, i);
+            write_varint(output_stream, h);
+            write_varint(output_stream, run_length);
+            for(; run_length > 0; run_length--, h++)
+                write_varint(output_stream, heatmap_grid[i][h]);
+        }
+    }
+}
+
+/**
+ * Writes the binary record with the number of censored simulations of the current simulation set, which precedes its heatmap record.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param num_censored_simulations Number of simulations stopped before the environment was empty.
+*/
+void write_binary_heatmap_censored(FILE *output_stream, int num_censored_simulations)
+{
+    fputc(HEATMAP_CENSORED, output_stream);
+    write_varint(output_stream, num_censored_simulations);
+}
+
+/**
+ * Deallocates the heatmap accumulators of all workers.
+*/
+void deallocate_heatmap_accumulators()
+{
+    for(int worker_index = 0; worker_index < num_heatmap_workers; worker_index++)
+        deallocate_grid((void **) worker_heatmaps[worker_index], cli_args.global_line_number);
+
+    free(worker_heatmaps);
+    worker_heatmaps = NULL;
+    num_heatmap_workers = 0;
+}
@@ -2,7 +2,7 @@
    File: initialization.c
    Author: Daniel Gonçalves
    Date: 2023-10-15
-   Description: This module implements functions responsible for opening environment, output, and auxiliary files, reading data from these files, allocating integer grids used by the program, and generating the environment if necessary.
+   Description: This module implements functions responsible for opening environment and output files, reading data from the environment file, allocating integer grids used by the program, and generating the environment if necessary.
 */
 
 
@@ -14,47 +14,24 @@
 
 #include"../headers/grid.h"
 #include"../headers/exit.h"
+#include"../headers/heatmap.h"
+#include"../headers/compression.h"
 #include"../headers/pedestrian.h"
 #include"../headers/initialization.h"
+#include"../headers/environment_file.h"
+#include"../headers/parallel_timestep.h"
 #include"../headers/cli_processing.h"
 #include"../headers/shared_resources.h"
 
-const char *environment_path = "environments/";
-const char *auxiliary_path = "auxiliary/";
 const char *output_path = "output/";
 
-static Function_Status open_environment_file(FILE **environment_file);
+static Function_Status allocate_environment_grids(int lines, int columns);
 static Function_Status symbol_processing(char read_char, Location coordinates);
 
-/**
- * Opens the auxiliary file in read mode.  
- * 
- * @param auxiliary_file Pointer to the FILE structure that will hold the file descriptor.
- * @return Function_Status: FAILURE (0) or SUCCESS (1).
-*/
-Function_Status open_auxiliary_file(FILE **auxiliary_file)
-{
-    char complete_path[500] = "";
-    
-    if( origin_uses_auxiliary_data() == true)
-    {
-        sprintf(complete_path,"%s%s",auxiliary_path,cli_args.auxiliary_filename);
-
-        *auxiliary_file = fopen(complete_path,"r");
-        if(*auxiliary_file == NULL)
-        {
-            fprintf(stderr, "It was not possible to open the auxiliary file.\n");
-            return FAILURE;
-        }
-    }
-
-    return SUCCESS;
-}
-
 /**
  * Opens the output file in write mode.
  * 
- * @note If no file name is provided with the -o option, a name is generated automatically.
+ * @note If no file name is provided with the -o option, a name is generated automatically. With the --compress option, the returned stream compresses the data before writing it to the file.
  * 
  * @param output_file Pointer to the FILE structure that will hold the file descriptor.
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
@@ -76,27 +53,46 @@ Function_Status open_output_file(FILE **output_file)
                 output_type_name = "evacuation_time";
             else if(cli_args.output_format == OUTPUT_HEATMAP)
                 output_type_name = "heatmap";
-            else
+            else if(cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
                 output_type_name = "distribution_variation";
+            else if(cli_args.output_format == OUTPUT_TIMESTEPS_STATISTICS)
+                output_type_name = "evacuation_statistics";
+            else if(cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE)
+                output_type_name = "paired_difference";
+            else
+                output_type_name = "trajectory";
             
             time_t current_time = time(NULL);
 	        struct tm * time_information = localtime(&current_time);
 	
 	        strftime(date_time,50,"%F_%Z_%T",time_information);
 
-            sprintf(complete_path,"%s%s-%s-%s.txt", output_path, output_type_name, 
-                    cli_args.environment_filename,date_time);
+            sprintf(complete_path,"%s%s-%s-%s.%s%s", output_path, output_type_name, 
+                    cli_args.environment_filename,date_time, is_output_binary() ? "bin" : "txt", get_compression_extension());
         }
         else
             sprintf(complete_path,"%s%s",output_path,cli_args.output_filename);
 
 
-        *output_file = fopen(complete_path,"w");
+        *output_file = fopen(complete_path, is_output_binary() || cli_args.compression_method != NO_COMPRESSION ? "wb" : "w");
         if(*output_file == NULL)
         {
             fprintf(stderr, "It was not possible to open the output file.\n");
             return FAILURE;
         }
+
+        if(cli_args.compression_method != NO_COMPRESSION)
+        {
+            FILE *compressed_file = open_compressed_stream(*output_file);
+            if(compressed_file == NULL)
+            {
+                fclose(*output_file);
+                *output_file = NULL;
+                return FAILURE;
+            }
+
+            *output_file = compressed_file;
+        }
     }
     else
         *output_file = stdout;
@@ -105,7 +101,7 @@ Function_Status open_output_file(FILE **output_file)
 }
 
 /**
- * Allocates the integer grids necessary for the program (environment, pedestrian and heatmap grids).
+ * Allocates the integer grids necessary for the program (environment, pedestrian and heatmap grids), as well as the heatmap accumulators for the heatmap output format.
  *  
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
@@ -120,6 +116,14 @@ Function_Status allocate_grids()
         return FAILURE;
     }
 
+    if(cli_args.output_format == OUTPUT_HEATMAP)
+    {
+        // Each band of the parallel timestep records its visits in its own accumulator.
+        int num_workers = cli_args.parallel_timestep ? get_timestep_band_quantity() : HEATMAP_WORKERS;
+        if(allocate_heatmap_accumulators(num_workers) == FAILURE)
+            return FAILURE;
+    }
+
     return SUCCESS;
 }
 
@@ -130,57 +134,7 @@ Function_Status allocate_grids()
 */
 Function_Status load_environment()
 {
-    FILE *environment_file = NULL;
-
-    if(open_environment_file(&environment_file) == FAILURE)
-        return FAILURE;
-
-    if( fscanf(environment_file,"%d %d", &(cli_args.global_line_number), &(cli_args.global_column_number)) != 2)
-    {
-        fprintf(stderr, "Environment dimensions weren't found in the first line of the file.\n");
-        return FAILURE;
-    }
-
-    if(allocate_grids() == FAILURE)
-        return FAILURE;
-
-    if(reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
-        return FAILURE;
-
-    char read_char = '\0';
-    fscanf(environment_file,"%c",&read_char);// responsible for eliminating the '\n' after the environment dimensions.
-    for(int i = 0; i < cli_args.global_line_number; i++)
-    {
-        int h = 0;
-        for(; h <= cli_args.global_column_number; h++)
-        {
-            if(fscanf(environment_file,"%c",&read_char) == EOF)
-                break;
-
-            if(h == cli_args.global_column_number && read_char != '\n')
-            {
-                // The end of a line should have been reached
-                fprintf(stderr,"Line %d has more columns than the extracted column number.\n", i);
-                return FAILURE;
-            }
-
-            if(read_char == '\n')
-                break;
-
-            if( symbol_processing(read_char,(Location){i,h}) == FAILURE)
-                return FAILURE;
-        }
-
-        if( h < cli_args.global_column_number)
-        {
-            fprintf(stderr,"Line %d has less columns than the extracted column number.\n", i);
-            return FAILURE;
-        }
-    }
-
-    fclose(environment_file);
-
-    return SUCCESS;
+    return read_environment_file(cli_args.environment_filename, allocate_environment_grids, symbol_processing);
 }
 
 /**
@@ -207,136 +161,26 @@ Function_Status generate_environment()
     return SUCCESS;
 }
 
-/**
- * Determines the number of simulation sets (number of non-empty lines) present in the auxiliary file.
- * 
- * @param auxiliary_file File where the simulation sets are stored.
- * @return A non-negative integer, indicating the number of simulation sets, or -1, in failure.
-*/
-int extract_simulation_set_quantity(FILE *auxiliary_file)
-{
-    if(auxiliary_file == NULL)
-        return -1;
-
-    char current_char = '\n', previous_char = '\n';
-    int count = 0; 
-
-    while(1)
-    {
-        previous_char = current_char;
-        current_char = fgetc(auxiliary_file);
-
-        if(current_char == '\n')
-        {
-            if(previous_char == '\n')
-                continue; // ignore empty lines
-
-            count++;
-        }
-
-        if(current_char == EOF)
-        {
-            if(previous_char != '\n')
-                count++; //Count the last line that hasn't ended with a newline
-
-            if(feof(auxiliary_file))
-                break;
-
-            if(ferror(auxiliary_file))
-            {
-                fprintf(stderr, "Error while reading the auxiliary file.");
-                return -1;
-            }
-        }
-    }
-
-    fseek(auxiliary_file, 0, SEEK_SET);
-
-    return count;
-}
-
-/**
- * Read the next line of the provided auxiliary file and extract the exits coordinates from it, adding them to the environment.
- * 
- * @param auxiliary_file File where the simulation sets are stored.
- * @param exit_number Pointer to a integer, where will be stored the number of exits in the simulation set.
- * 
- * @return Function_Status: FAILURE (0) or SUCCESS (1).
-*/
-Function_Status get_next_simulation_set(FILE *auxiliary_file, int *exit_number)
-{
-    Location temp_coordinates;
-    int exit_count = 0; // Number of extracted exits.
-    char read_char = '\0';
-   
-    bool new_exit = true; // True for a new exit, False for an expansion over the last new exit.
-
-    while(1)
-    {
-        int returned_value = fscanf(auxiliary_file,"%d %d %c ",&temp_coordinates.lin,&temp_coordinates.col,&read_char);
-
-        if( returned_value == EOF)
-            break; // All simulation sets were processed.
-
-        if( returned_value != 3)
-        {
-            fprintf(stderr, "Failure while reading the auxiliary file for exit coordinates. Verify if the syntax is being correctly followed.\n");
-            return FAILURE;
-        }
-
-        if(new_exit == true)
-        {
-            exit_count++;
-            if( add_new_exit(temp_coordinates) == FAILURE)
-                return FAILURE;
-        }
-        else
-        {
-            if( expand_exit(exits_set.list[exits_set.num_exits - 1],temp_coordinates) == FAILURE)
-                return FAILURE;
-        }
-
-        if(read_char == '+')
-            new_exit = false;
-        else if(read_char == ',')
-            new_exit = true;
-        else if(read_char == '.')
-            break;
-        else
-        {
-            fprintf(stderr, "Unknow symbol in the auxiliary file.\n");
-            return FAILURE;
-        }
-    }
-
-    *exit_number = exit_count;
-
-    return SUCCESS;
-}
-
 /* ---------------- ---------------- ---------------- ---------------- ---------------- */
 /* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
 /* ---------------- ---------------- ---------------- ---------------- ---------------- */
 
 /**
- * Opens the environment file in read mode.
+ * Sets the dimensions of the environment read from the environment file and allocates the grids.
  * 
- * @param environment_file Pointer to the FILE structure that will hold the file descriptor.
+ * @param lines Number of lines of the environment.
+ * @param columns Number of columns of the environment.
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
-static Function_Status open_environment_file(FILE **environment_file)
+static Function_Status allocate_environment_grids(int lines, int columns)
 {
-    char complete_path[300] = "";
-    sprintf(complete_path,"%s%s",environment_path,cli_args.environment_filename);
+    cli_args.global_line_number = lines;
+    cli_args.global_column_number = columns;
 
-    *environment_file = fopen(complete_path, "r");
-    if(*environment_file == NULL)
-    {
-        fprintf(stderr,"It was not possible to open the environment file: %s.\n",cli_args.environment_filename);
+    if(allocate_grids() == FAILURE)
         return FAILURE;
-    }
 
-    return SUCCESS;
+    return reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number);
 }
 
 /**
@@ -377,6 +221,7 @@ static Function_Status symbol_processing(char read_char, Location coordinates)
                     return FAILURE;
 
                 pedestrian_position_grid[coordinates.lin][coordinates.col] = pedestrian_set.list[pedestrian_set.num_pedestrians - 1]->id;
+                record_heatmap_visit(coordinates);
             }
             environment_only_grid[coordinates.lin][coordinates.col] = 0;
 
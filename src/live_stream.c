@@ -0,0 +1,175 @@
+/*
+   File: live_stream.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module publishes snapshots of the environment into a POSIX shared memory ring buffer, so that an external viewer can watch the simulations while they run. Publishing never waits for the viewer: when it falls behind, older frames are overwritten and skipped. The layout of the shared memory is described in live_stream.h.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/live_stream.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static unsigned char *shared_memory = NULL;
+static size_t shared_memory_size = 0;
+static size_t slot_size = 0;
+static unsigned char *set_cells = NULL; // Walls and exits of the current simulation set, copied to each frame before the pedestrians.
+static uint64_t published_frames = 0;
+static int set_index = -1;
+
+/**
+ * Creates (or truncates) the shared memory object named by --live-stream and maps it into memory.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status open_live_stream()
+{
+    int num_cells = cli_args.global_line_number * cli_args.global_column_number;
+
+    slot_size = live_stream_slot_size(cli_args.global_line_number, cli_args.global_column_number);
+    shared_memory_size = LIVE_STREAM_HEADER_SIZE + slot_size * LIVE_STREAM_SLOTS;
+
+    set_cells = malloc(num_cells);
+    if(set_cells == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the live stream cells.\n");
+        return FAILURE;
+    }
+
+    int shared_memory_descriptor = shm_open(cli_args.live_stream_name, O_CREAT | O_RDWR, 0644);
+    if(shared_memory_descriptor == -1)
+    {
+        fprintf(stderr, "It was not possible to open the shared memory object: %s.\n", cli_args.live_stream_name);
+        return FAILURE;
+    }
+
+    if(ftruncate(shared_memory_descriptor, 0) == -1 || ftruncate(shared_memory_descriptor, shared_memory_size) == -1)
+    {
+        fprintf(stderr, "It was not possible to resize the shared memory object: %s.\n", cli_args.live_stream_name);
+        close(shared_memory_descriptor);
+        return FAILURE;
+    }
+
+    shared_memory = mmap(NULL, shared_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, shared_memory_descriptor, 0);
+    close(shared_memory_descriptor);
+    if(shared_memory == MAP_FAILED)
+    {
+        fprintf(stderr, "It was not possible to map the shared memory object: %s.\n", cli_args.live_stream_name);
+        shared_memory = NULL;
+        return FAILURE;
+    }
+
+    Live_Stream_Header *header = (Live_Stream_Header *) shared_memory;
+    header->version = LIVE_STREAM_VERSION;
+    header->line_number = cli_args.global_line_number;
+    header->column_number = cli_args.global_column_number;
+    header->num_slots = LIVE_STREAM_SLOTS;
+    atomic_store(&header->finished, 0);
+    atomic_store(&header->latest_frame, 0);
+
+    // The magic is written last, so a viewer never accepts a partially initialized header.
+    atomic_thread_fence(memory_order_release);
+    memcpy(header->magic, LIVE_STREAM_MAGIC, sizeof(header->magic));
+
+    return SUCCESS;
+}
+
+/**
+ * Stores the walls and exits of the current simulation set, which are shared by all of its frames.
+*/
+void begin_live_stream_set()
+{
+    if(shared_memory == NULL)
+        return;
+
+    set_index++;
+
+    for(int i = 0; i < cli_args.global_line_number; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+            set_cells[i * cli_args.global_column_number + h] = environment_only_grid[i][h] == WALL_VALUE ? LIVE_WALL_CELL : LIVE_EMPTY_CELL;
+    }
+
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+        for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+        {
+            Location coordinates = current_exit->coordinates[cell_index];
+            set_cells[coordinates.lin * cli_args.global_column_number + coordinates.col] = LIVE_EXIT_CELL;
+        }
+    }
+}
+
+/**
+ * Publishes a snapshot of the current position of the pedestrians in the next slot of the ring buffer.
+ *
+ * @param simulation_index Index of the simulation within the simulation set.
+ * @param timestep Current timestep of the simulation.
+*/
+void publish_live_frame(int simulation_index, int timestep)
+{
+    if(shared_memory == NULL)
+        return;
+
+    Live_Stream_Header *header = (Live_Stream_Header *) shared_memory;
+    uint64_t frame_number = published_frames + 1;
+    unsigned char *slot = shared_memory + LIVE_STREAM_HEADER_SIZE + slot_size * ((frame_number - 1) % LIVE_STREAM_SLOTS);
+    Live_Frame_Header *frame_header = (Live_Frame_Header *) slot;
+    unsigned char *cells = slot + sizeof(Live_Frame_Header);
+
+    atomic_store_explicit(&frame_header->sequence, 2 * frame_number - 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    memcpy(cells, set_cells, cli_args.global_line_number * cli_args.global_column_number);
+
+    int num_pedestrians = 0;
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state == GOT_OUT)
+            continue;
+
+        cells[current_pedestrian->current.lin * cli_args.global_column_number + current_pedestrian->current.col] = LIVE_PEDESTRIAN_CELL;
+        num_pedestrians++;
+    }
+
+    frame_header->set_index = set_index;
+    frame_header->simulation_index = simulation_index;
+    frame_header->timestep = timestep;
+    frame_header->num_pedestrians = num_pedestrians;
+
+    atomic_store_explicit(&frame_header->sequence, 2 * frame_number, memory_order_release);
+    atomic_store_explicit(&header->latest_frame, frame_number, memory_order_release);
+
+    published_frames = frame_number;
+}
+
+/**
+ * Marks the stream as finished, unmaps it and removes the shared memory object (viewers that already mapped it keep their copy).
+*/
+void close_live_stream()
+{
+    if(shared_memory != NULL)
+    {
+        atomic_store(&((Live_Stream_Header *) shared_memory)->finished, 1);
+        munmap(shared_memory, shared_memory_size);
+        shm_unlink(cli_args.live_stream_name);
+    }
+
+    free(set_cells);
+
+    shared_memory = NULL;
+    set_cells = NULL;
+    published_frames = 0;
+    set_index = -1;
+}
@@ -10,40 +10,54 @@
 #include<string.h>
 #include<argp.h>
 #include<unistd.h>
-#include<math.h>
 
 #include"../headers/exit.h"
 #include"../headers/pedestrian.h"
+#include"../headers/statistics.h"
+#include"../headers/random_stream.h"
+#include"../headers/heatmap.h"
+#include"../headers/trajectory.h"
+#include"../headers/live_stream.h"
 #include"../headers/initialization.h"
+#include"../headers/auxiliary_file.h"
+#include"../headers/environment_file.h"
+#include"../headers/field_cache.h"
+#include"../headers/thread_pool.h"
+#include"../headers/parallel_timestep.h"
+#include"../headers/batch_engine.h"
+#include"../headers/timestep_variants.h"
+#include"../headers/occupancy_bitboard.h"
+#include"../headers/placement.h"
+#include"../headers/watchdog.h"
+#include"../headers/output_writer.h"
 #include"../headers/cli_processing.h"
 #include"../headers/printing_utilities.h"
 #include"../headers/shared_resources.h"
 
-#define TOLERANCE 1e-8
-
 static Function_Status run_simulations(FILE *output_file);
-static Function_Status conflict_solving();
-static void deallocate_program_structures(FILE *output_file, FILE *auxiliary_file);
-static double calculate_delta();
+static Function_Status run_simulation(FILE *output_file, int simu_index, Simulation_Result *result);
+static void record_simulation_result(FILE *output_file, int simu_index, Simulation_Result result, int *simulation_target);
+static void deallocate_program_structures(FILE *output_file);
+
+static Streaming_Statistics evacuation_statistics; // Accumulates the evacuation times of the current simulation set.
+static int *current_timesteps = NULL; // Evacuation times of the current simulation set, indexed by simulation (output format 6).
+static int *reference_timesteps = NULL; // Evacuation times of the reference simulation set, indexed by simulation (output format 6).
+static int num_censored_simulations = 0; // Simulations of the current simulation set stopped by the watchdog.
+static Simulation_Result *batch_results = NULL; // Results of the simulations advanced together (--batch-seeds).
 
 int main(int argc, char **argv)
 {
-    FILE *auxiliary_file = NULL;
     FILE *output_file = NULL;
     int simulation_set_quantity = 1; // Origins that use static exits have a single simulation set.
     int simulation_set_index = 0;
-    int current_exit_number = 0;
+    int last_simulation_set_index = 0;
 
     if(argp_parse(&argp, argc, argv,0,0,&cli_args) != 0)
         return END_PROGRAM;
 
-    if(open_auxiliary_file(&auxiliary_file) == FAILURE)
-        return END_PROGRAM;
-    
-    if(open_output_file( &output_file) == FAILURE)
+    if(strcmp(cli_args.converted_environment_filename, "") != 0)
     {
-        if(auxiliary_file != NULL)
-            fclose(auxiliary_file);
+        convert_environment_file(cli_args.environment_filename, cli_args.converted_environment_filename);
         return END_PROGRAM;
     }
 
@@ -58,27 +72,67 @@ int main(int argc, char **argv)
             return END_PROGRAM;
     }
 
-    print_full_command(output_file);
+    select_timestep_variant();
+
+    if(open_auxiliary_file() == FAILURE)
+    {
+        close_auxiliary_file();
+        return END_PROGRAM;
+    }
+
+    if(origin_uses_auxiliary_data() == true)
+    {
+        simulation_set_index = cli_args.first_set - 1;
+        last_simulation_set_index = cli_args.last_set == 0 ? get_simulation_set_quantity() - 1 : cli_args.last_set - 1;
+        if(last_simulation_set_index >= get_simulation_set_quantity() ||
+           (simulation_set_index > last_simulation_set_index && (get_simulation_set_quantity() > 0 || cli_args.first_set > 1)))
+        {
+            fprintf(stderr, "The auxiliary file has only %d simulation sets.\n", get_simulation_set_quantity());
+            close_auxiliary_file();
+            return END_PROGRAM;
+        }
+
+        simulation_set_quantity = last_simulation_set_index - simulation_set_index + 1;
+    }
+    
+    if(open_output_file( &output_file) == FAILURE || configure_output_buffer(&output_file) == FAILURE)
+    {
+        close_auxiliary_file();
+        return END_PROGRAM;
+    }
+
+    if(strcmp(cli_args.live_stream_name, "") != 0)
+    {
+        if(open_live_stream() == FAILURE)
+            return END_PROGRAM;
+    }
 
-    if(auxiliary_file != NULL)
+    if(cli_args.output_format == OUTPUT_TRAJECTORY)
     {
-        simulation_set_quantity = extract_simulation_set_quantity(auxiliary_file);
-        if(simulation_set_quantity == -1)
+        if(write_trajectory_header(output_file) == FAILURE)
             return END_PROGRAM;
     }
+    else if(cli_args.output_format == OUTPUT_HEATMAP && cli_args.heatmap_encoding == HEATMAP_BINARY)
+        write_binary_heatmap_header(output_file);
+    else
+        print_full_command(output_file);
 
     do
     {
         if(origin_uses_auxiliary_data() == true)
         {
-            if( get_next_simulation_set(auxiliary_file, &current_exit_number) == FAILURE)
-                return END_PROGRAM;
-
-            if(current_exit_number == 0)
+            if(simulation_set_index > last_simulation_set_index)
                 break; // All simulation sets were processed.
+
+            if( load_simulation_set(simulation_set_index) == FAILURE)
+                return END_PROGRAM;
         }
 
-        if(cli_args.show_simulation_set_info)
+        begin_live_stream_set();
+
+        if(cli_args.output_format == OUTPUT_TRAJECTORY)
+            write_trajectory_set(output_file);
+        else if(cli_args.show_simulation_set_info)
             print_simulation_set_information(output_file);
 
         int returned_value = calculate_all_static_weights();
@@ -86,15 +140,32 @@ int main(int argc, char **argv)
             return END_PROGRAM;
         else if(returned_value == INACCESSIBLE_EXIT)
         {
-            if(cli_args.output_format != OUTPUT_TIMESTEPS_COUNT)
-                fprintf(output_file, "At least one exit from the simulation set is inaccessible.\n");
-            else
+            if(cli_args.output_format == OUTPUT_TIMESTEPS_COUNT)
                 print_placeholder(output_file, -1);
+            else if(cli_args.output_format == OUTPUT_TIMESTEPS_STATISTICS)
+            {
+                reset_streaming_statistics(&evacuation_statistics);
+                print_evacuation_statistics(output_file, &evacuation_statistics);
+                if(is_watchdog_enabled())
+                    write_integer(output_file, 0, ' ');
+                fprintf(output_file, "\n");
+            }
+            else if(cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE)
+            {
+                print_paired_difference(output_file, NULL, NULL, 0);
+                if(is_watchdog_enabled())
+                    write_integer(output_file, 0, ' ');
+                fprintf(output_file, "\n");
+            }
+            else if(cli_args.output_format == OUTPUT_HEATMAP && cli_args.heatmap_encoding == HEATMAP_BINARY)
+                write_binary_heatmap(output_file, 0);
+            else if(cli_args.output_format != OUTPUT_TRAJECTORY) // A trajectory set record without simulations indicates it.
+                fprintf(output_file, "At least one exit from the simulation set is inaccessible.\n");
 
             if(origin_uses_auxiliary_data() == true)
                 deallocate_exits();
 
-            print_execution_status(simulation_set_index, simulation_set_quantity);
+            print_execution_status(simulation_set_index - (cli_args.first_set - 1), simulation_set_quantity);
             simulation_set_index++;
 
             continue;
@@ -108,25 +179,47 @@ int main(int argc, char **argv)
             return END_PROGRAM;
 
         if(origin_uses_auxiliary_data() == true)
+        {
             deallocate_exits();
+            deallocate_placement_cells(); // The free cells depend on the exits.
+        }
 
-        if(cli_args.output_format == OUTPUT_TIMESTEPS_COUNT || cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
+        if(cli_args.output_format == OUTPUT_TIMESTEPS_COUNT || cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION ||
+           cli_args.output_format == OUTPUT_TIMESTEPS_STATISTICS || cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE)
             fprintf(output_file, "\n");
 
         if(cli_args.output_format == OUTPUT_HEATMAP)
         {
-            print_heatmap(output_file);        
+            reduce_heatmap_accumulators();
+
+            if(cli_args.heatmap_encoding == HEATMAP_BINARY)
+            {
+                if(num_censored_simulations > 0)
+                    write_binary_heatmap_censored(output_file, num_censored_simulations);
+                write_binary_heatmap(output_file, cli_args.num_simulations);
+            }
+            else
+            {
+                if(cli_args.heatmap_encoding == HEATMAP_SPARSE)
+                    print_sparse_heatmap(output_file);
+                else
+                    print_heatmap(output_file);
+
+                if(num_censored_simulations > 0)
+                    fprintf(output_file, "Censored simulations: %d\n\n", num_censored_simulations);
+            }
+
             reset_integer_grid(heatmap_grid, cli_args.global_line_number, cli_args.global_column_number);
         }     
 
-        print_execution_status(simulation_set_index, simulation_set_quantity);
+        print_execution_status(simulation_set_index - (cli_args.first_set - 1), simulation_set_quantity);
         simulation_set_index++;
 
         if(origin_uses_static_exits() == true) // Only a single simulation set.
             break;
     }while(true);
 
-    deallocate_program_structures(output_file, auxiliary_file);
+    deallocate_program_structures(output_file);
 
     return END_PROGRAM;
 }
@@ -140,164 +233,257 @@ int main(int argc, char **argv)
 static Function_Status run_simulations(FILE *output_file)
 {
     if(cli_args.single_exit_flag == true && exits_set.num_exits == 1 && 
-        (cli_args.output_format == OUTPUT_TIMESTEPS_COUNT || cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION))
+        (cli_args.output_format == OUTPUT_TIMESTEPS_COUNT || cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION ||
+         cli_args.output_format == OUTPUT_TIMESTEPS_STATISTICS || cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE))
     {
         fprintf(output_file, "#1 "); // simulation set where the exit was combined with itself. Used to correct errors in the plotting program.
     }
 
-    for(int simu_index = 0; simu_index < cli_args.num_simulations; simu_index++, cli_args.seed++)
+    reset_streaming_statistics(&evacuation_statistics);
+    num_censored_simulations = 0;
+
+    if(cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE && current_timesteps == NULL)
     {
-        srand(cli_args.seed);
+        current_timesteps = malloc(sizeof(int) * cli_args.num_simulations);
+        if(current_timesteps == NULL)
+        {
+            fprintf(stderr, "Failure in the allocation of the current_timesteps list.\n");
+            return FAILURE;
+        }
+    }
 
-        if(origin_uses_static_pedestrians() == false)
+    if(batch_results == NULL)
+    {
+        batch_results = malloc(sizeof(Simulation_Result) * cli_args.batch_seeds);
+        if(batch_results == NULL)
         {
-            if( insert_pedestrians_at_random(cli_args.total_num_pedestrians) == FAILURE)
-                return FAILURE;
+            fprintf(stderr, "Failure in the allocation of the batch_results list.\n");
+            return FAILURE;
         }
-        
-        if(cli_args.output_format == OUTPUT_VISUALIZATION)
-            print_pedestrian_position_grid(output_file, simu_index, 0);
+    }
 
-        int number_timesteps = 0;
-        while(is_environment_empty() == false)
+    int first_seed = cli_args.seed; // With common random numbers, every simulation set restarts from the same seed.
+
+    int simulation_target = cli_args.num_simulations; // Grows in batches when the adaptive number of simulations is enabled.
+    for(int simu_index = 0; simu_index < simulation_target;)
+    {
+        // A batch never goes beyond the target, so the target only grows after the last simulation of a batch.
+        int batch_size = simulation_target - simu_index < cli_args.batch_seeds ? simulation_target - simu_index : cli_args.batch_seeds;
+
+        if(batch_size > 1)
         {
-            if(cli_args.show_debug_information)
-            {
-                print_int_grid(pedestrian_position_grid);
-                printf("\nTimestep %d.\n", number_timesteps + 1);
-            }
-            
-            if(calculate_all_dynamic_weights() == FAILURE)
+            if(run_simulation_batch(batch_size, batch_results) == FAILURE)
                 return FAILURE;
+        }
+        else if(run_simulation(output_file, simu_index, &batch_results[0]) == FAILURE)
+            return FAILURE;
 
-            if(calculate_all_exits_floor_field() == FAILURE)
-                return FAILURE;
+        for(int batch_index = 0; batch_index < batch_size; batch_index++, simu_index++, cli_args.seed++)
+            record_simulation_result(output_file, simu_index, batch_results[batch_index], &simulation_target);
+    }
 
-            if(calculate_final_floor_field() == FAILURE)
-                return FAILURE;
+    if(cli_args.output_format == OUTPUT_TIMESTEPS_STATISTICS)
+        print_evacuation_statistics(output_file, &evacuation_statistics);
+
+    if(cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE)
+    {
+        if(reference_timesteps == NULL)
+        {
+            // The first simulation set to run becomes the reference for all the others.
+            reference_timesteps = current_timesteps;
+            current_timesteps = NULL;
+            print_paired_difference(output_file, reference_timesteps, reference_timesteps, cli_args.num_simulations);
+        }
+        else
+            print_paired_difference(output_file, reference_timesteps, current_timesteps, cli_args.num_simulations);
+    }
 
-            if(cli_args.show_debug_information)
-                print_double_grid(exits_set.final_floor_field);
+    if((cli_args.output_format == OUTPUT_TIMESTEPS_STATISTICS || cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE) && is_watchdog_enabled())
+        write_integer(output_file, num_censored_simulations, ' ');
 
-            if(cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
-                break; 
-            // The delta calculation only requires that the static and dynamic weights have already been calculated (for the first timestep).
+    if(cli_args.common_random_numbers)
+        cli_args.seed = first_seed;
 
-            evaluate_pedestrians_movements();
-            determine_pedestrians_in_panic();
-            
-            if(!cli_args.allow_X_movement)
-                block_X_movement(); // Runs when allow_X_movement is false.
-            
-            if(conflict_solving() == FAILURE)
-                return FAILURE;
-            
-            apply_pedestrian_movement();
+    return SUCCESS;
+}
 
-            update_pedestrian_position_grid();
-            reset_pedestrian_state();
-            reset_pedestrian_panic();
-            
-            number_timesteps++;
+/**
+ * Runs a single simulation of the current simulation set, with the seed cli_args.seed, printing the data of each timestep if appropriate.
+ *
+ * @param output_file Stream where the output data will be written.
+ * @param simu_index Index of the simulation in the simulation set.
+ * @param result Where the result of the simulation will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status run_simulation(FILE *output_file, int simu_index, Simulation_Result *result)
+{
+    srand(cli_args.seed);
+    reset_random_streams(cli_args.seed);
 
-            if(cli_args.output_format == OUTPUT_VISUALIZATION)
-            {
-                if(!cli_args.write_to_file)
-                    sleep(1);
-                    
-                print_pedestrian_position_grid(output_file, simu_index,number_timesteps);
-            }
+    if(origin_uses_static_pedestrians() == false)
+    {
+        if( insert_pedestrians_at_random(cli_args.total_num_pedestrians) == FAILURE)
+            return FAILURE;
+    }
+    
+    if(cli_args.output_format == OUTPUT_VISUALIZATION)
+    {
+        print_pedestrian_position_grid(output_file, simu_index, 0);
+        flush_output_stream(output_file);
+    }
+
+    if(cli_args.output_format == OUTPUT_TRAJECTORY)
+    {
+        if(write_trajectory_simulation_start(output_file, simu_index) == FAILURE)
+            return FAILURE;
+    }
+
+    publish_live_frame(simu_index, 0);
 
+    int number_timesteps = 0;
+    int timesteps_without_progress = 0;
+    enum Censoring_Reason censoring = NOT_CENSORED;
+    while(is_environment_empty() == false)
+    {
+        if(cli_args.show_debug_information)
+        {
+            print_int_grid(pedestrian_position_grid);
+            printf("\nTimestep %d.\n", number_timesteps + 1);
         }
+        
+        if(calculate_all_dynamic_weights() == FAILURE)
+            return FAILURE;
 
-        if(origin_uses_static_pedestrians() == true)
-            reset_pedestrians_structures();
-        else
-            deallocate_pedestrians();
+        if(calculate_all_exits_floor_field() == FAILURE)
+            return FAILURE;
 
-        if(cli_args.output_format == OUTPUT_TIMESTEPS_COUNT)
-            fprintf(output_file,"%d ", number_timesteps);
+        if(calculate_final_floor_field() == FAILURE)
+            return FAILURE;
+
+        if(cli_args.show_debug_information)
+            print_double_grid(exits_set.final_floor_field);
 
         if(cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
-            fprintf(output_file,"%.3lf ", calculate_delta());
+            break; 
+        // The delta calculation only requires that the static and dynamic weights have already been calculated (for the first timestep).
+
+        if(run_timestep() == FAILURE)
+            return FAILURE;
+        
+        number_timesteps++;
+
+        if(cli_args.output_format == OUTPUT_VISUALIZATION)
+        {
+            if(!cli_args.write_to_file)
+                sleep(1);
+                
+            print_pedestrian_position_grid(output_file, simu_index,number_timesteps);
+            flush_output_stream(output_file);
+        }
+
+        if(cli_args.output_format == OUTPUT_TRAJECTORY)
+            write_trajectory_timestep(output_file);
+
+        publish_live_frame(simu_index, number_timesteps);
+
+        if(is_watchdog_enabled() && is_environment_empty() == false)
+        {
+            censoring = check_simulation_progress(number_timesteps, &timesteps_without_progress);
+            if(censoring != NOT_CENSORED)
+                break;
+        }
     }
 
+    if(censoring != NOT_CENSORED && cli_args.output_format == OUTPUT_VISUALIZATION)
+        fprintf(output_file, "Simulation %d censored after %d timesteps: %s.\n\n", simu_index, number_timesteps, get_censoring_description(censoring));
+
+    if(cli_args.output_format == OUTPUT_TRAJECTORY)
+        write_trajectory_simulation_end(output_file, number_timesteps, censoring != NOT_CENSORED);
+
+    if(origin_uses_static_pedestrians() == true)
+        reset_pedestrians_structures();
+    else
+        deallocate_pedestrians();
+
+    result->number_timesteps = number_timesteps;
+    result->censoring = censoring;
+    if(cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
+        result->delta = calculate_distribution_delta();
+
     return SUCCESS;
 }
 
 /**
- * Calls the necessary functions to identify and solve conflicts between pedestrians.
- * @return Function_Status: FAILURE (0) or SUCCESS (1).
+ * Prints and accumulates the result of a simulation, growing the number of simulations of the simulation set when the adaptive number of simulations requires it. Censored simulations are counted, but left out of the statistics.
+ *
+ * @param output_file Stream where the output data will be written.
+ * @param simu_index Index of the simulation in the simulation set.
+ * @param result Result of the simulation.
+ * @param simulation_target Number of simulations of the simulation set, which may be increased.
 */
-static Function_Status conflict_solving()
+static void record_simulation_result(FILE *output_file, int simu_index, Simulation_Result result, int *simulation_target)
 {
-    Cell_Conflict pedestrian_conflicts = NULL;
-    int num_conflicts = 0;
+    bool is_censored = result.censoring != NOT_CENSORED;
 
-    if(identify_pedestrian_conflicts(&pedestrian_conflicts, &num_conflicts) == FAILURE)
-        return FAILURE;                
+    if(cli_args.output_format == OUTPUT_TIMESTEPS_COUNT)
+    {
+        write_integer(output_file, result.number_timesteps, is_censored ? '+' : ' ');
+        if(is_censored)
+            write_text(output_file, " ");
+    }
 
-    if(solve_pedestrian_conflicts(pedestrian_conflicts, num_conflicts) == FAILURE)
-        return FAILURE;
+    if(cli_args.output_format == OUTPUT_DISTRIBUTION_VARIATION)
+        write_fixed(output_file, result.delta, 3, ' ');
 
-    if(cli_args.show_debug_information)
-        print_pedestrian_conflict_information(pedestrian_conflicts, num_conflicts);
+    if(is_censored)
+        num_censored_simulations++;
+    else
+        add_streaming_statistics_value(&evacuation_statistics, result.number_timesteps);
 
-    free(pedestrian_conflicts);
+    if(cli_args.output_format == OUTPUT_PAIRED_DIFFERENCE)
+        current_timesteps[simu_index] = is_censored ? -1 : result.number_timesteps; // Pairs with a censored simulation are left out.
 
-    return SUCCESS;
+    if(simu_index == *simulation_target - 1 && cli_args.ci_tolerance > 0 && *simulation_target < cli_args.max_simulations)
+    {
+        if(calculate_confidence_half_width(evacuation_statistics.count, calculate_streaming_variance(&evacuation_statistics)) >= cli_args.ci_tolerance)
+        {
+            *simulation_target += cli_args.simulation_batch;
+            if(*simulation_target > cli_args.max_simulations)
+                *simulation_target = cli_args.max_simulations;
+        }
+    }
 }
 
  /**
   * Close opened files and deallocate structures used throughout the program.
   * 
   * @param output_file
-  * @param auxiliary_file
  */
-static void deallocate_program_structures(FILE *output_file, FILE *auxiliary_file)
+static void deallocate_program_structures(FILE *output_file)
 {
-    if(auxiliary_file != NULL)
-        fclose(auxiliary_file);
+    close_auxiliary_file();
 
     if(output_file != NULL && output_file != stdout)
         fclose(output_file);
 
     deallocate_pedestrians();
     deallocate_exits();
+    deallocate_field_cache();
+    deallocate_thread_pool();
+    deallocate_parallel_timestep();
+    deallocate_batch_engine();
+    deallocate_neighbor_bitboards();
+    deallocate_placement_cells();
+    deallocate_random_streams();
+    deallocate_trajectory();
+    deallocate_heatmap_accumulators();
+    close_live_stream();
+
+    free(current_timesteps);
+    free(reference_timesteps);
+    free(batch_results);
     
     deallocate_grid((void **) environment_only_grid,cli_args.global_line_number);
     deallocate_grid((void **) pedestrian_position_grid,cli_args.global_line_number);
     deallocate_grid((void **) heatmap_grid,cli_args.global_line_number);
 }
-
-/**
- * Calculates the value of delta (static delta or first timestep delta).
- * Delta is a value between 0 and 1 (inclusive) that indicates the distribution of pedestrians between two exits in an environment. Values close to 0 indicate a balanced preference between both doors, while values close to 1 indicate a strong preference of pedestrians for one exit over the other.
- * 
- * @return The calculated delta, as a double.
-*/
-static double calculate_delta()
-{
-    if(exits_set.num_exits != 2)
-        return 1; // The delta is calculated only for situations where the environments has two exits.
-                  // All other cases, with a single exit in particular, will receive a value of 1.
-
-    // Alpha == 0 indicates that the static delta is required.
-    Double_Grid exit_A = cli_args.alpha == 0 ? exits_set.list[0]->static_weight : exits_set.list[0]->floor_field;
-    Double_Grid exit_B = cli_args.alpha == 0 ? exits_set.list[1]->static_weight : exits_set.list[1]->floor_field;
-
-    int N_A = 0; // The number of cells where the floor field of exit_A is greater or equal to the floor field of exit_B. 
-    for(int i = 0; i < cli_args.global_line_number; i++)
-    {
-        for(int h = 0; h < cli_args.global_column_number; h++)
-        {
-            if(exit_A[i][h] == WALL_VALUE || exit_A[i][h] == EXIT_VALUE || exit_B[i][h] == EXIT_VALUE)
-                continue;
-
-            if(pedestrian_position_grid[i][h] != 0 && exit_B[i][h] <= exit_A[i][h] + TOLERANCE)
-                N_A++;
-        }
-    }
-
-    return 1.0 - (fmin(N_A, pedestrian_set.num_pedestrians - N_A) / fmax(N_A, pedestrian_set.num_pedestrians - N_A));
-}
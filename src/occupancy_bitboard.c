@@ -0,0 +1,179 @@
+/*
+   File: occupancy_bitboard.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module keeps the bitboards read by the specialized timesteps: the occupancy bitboard, with the cells of the pedestrians, and the wall bitboard, with the walls of the final floor field. With them, the neighbors of a cell that are walls or occupied are read as two 8-bit masks, built from three words of each bitboard, and the admissible_neighbors table turns the walls into the neighbors that can be reached, so the free admissible neighbors of a pedestrian are a single AND. The wall bitboard is rebuilt only when the final floor field changes, while the occupancy bitboard is rebuilt from the pedestrians at the start of each timestep, alongside pedestrian_position_grid, so the simulations of --batch-seeds can take turns.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/occupancy_bitboard.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+// Neighbors in the order scanned by find_smallest_cell, which decides the ties of the sorted neighborhood.
+const Location neighbor_offsets[8] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+
+uint64_t *occupancy_bitboard = NULL;
+uint64_t *wall_bitboard = NULL;
+int bitboard_words_per_line = 0;
+Neighbor_Mask admissible_neighbors[2][256];
+
+static unsigned int wall_bitboard_version = 0; // Version of the final floor field read by wall_bitboard (0 if none).
+
+static Function_Status allocate_neighbor_bitboards();
+static void fill_admissible_neighbors();
+static void build_wall_bitboard();
+static void build_occupancy_bitboard();
+static void set_bitboard_cell(uint64_t *bitboard, int line, int column);
+
+/**
+ * Updates the bitboards for the current timestep: the wall bitboard, if the final floor field changed, and the occupancy bitboard, with the current positions of the pedestrians.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status prepare_neighbor_bitboards()
+{
+    if(occupancy_bitboard == NULL && allocate_neighbor_bitboards() == FAILURE)
+        return FAILURE;
+
+    if(wall_bitboard_version != exits_set.final_floor_field_version)
+    {
+        build_wall_bitboard();
+        wall_bitboard_version = exits_set.final_floor_field_version;
+    }
+
+    build_occupancy_bitboard();
+
+    return SUCCESS;
+}
+
+/**
+ * Deallocates the bitboards.
+*/
+void deallocate_neighbor_bitboards()
+{
+    free(occupancy_bitboard);
+    free(wall_bitboard);
+    occupancy_bitboard = NULL;
+    wall_bitboard = NULL;
+    wall_bitboard_version = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Allocates the bitboards for the dimensions of the environment and fills the admissible_neighbors table.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status allocate_neighbor_bitboards()
+{
+    // The bits go from 0 to the number of columns + 1, and the last word of each line is only read.
+    bitboard_words_per_line = (cli_args.global_column_number + 2) / 64 + 1;
+    size_t num_words = (size_t) (cli_args.global_line_number + 2) * bitboard_words_per_line;
+
+    occupancy_bitboard = calloc(num_words, sizeof(uint64_t));
+    wall_bitboard = calloc(num_words, sizeof(uint64_t));
+    if(occupancy_bitboard == NULL || wall_bitboard == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the neighbor bitboards.\n");
+        deallocate_neighbor_bitboards();
+        return FAILURE;
+    }
+
+    fill_admissible_neighbors();
+
+    return SUCCESS;
+}
+
+/**
+ * Fills the admissible_neighbors table, with the rules of find_smallest_cell: a neighbor can be reached if it is not a wall and, for the diagonals, if is_diagonal_valid accepts the adjacent vertical and horizontal cells.
+*/
+static void fill_admissible_neighbors()
+{
+    // Bits of the vertical and horizontal cells adjacent to each neighbor (the same bit for the orthogonal ones).
+    static const int vertical_bit[8] = {1, 1, 1, 3, 4, 6, 6, 6};
+    static const int horizontal_bit[8] = {3, 1, 4, 3, 4, 3, 6, 4};
+    static const bool is_diagonal[8] = {true, false, true, false, false, true, false, true};
+
+    for(int prevent_corner_crossing = 0; prevent_corner_crossing < 2; prevent_corner_crossing++)
+    {
+        for(int walls = 0; walls < 256; walls++)
+        {
+            Neighbor_Mask admissible = 0;
+
+            for(int n_index = 0; n_index < 8; n_index++)
+            {
+                if(walls >> n_index & 1)
+                    continue;
+
+                if(is_diagonal[n_index])
+                {
+                    bool is_vertical_blocked = walls >> vertical_bit[n_index] & 1;
+                    bool is_horizontal_blocked = walls >> horizontal_bit[n_index] & 1;
+
+                    if(prevent_corner_crossing ? (is_vertical_blocked || is_horizontal_blocked) : (is_vertical_blocked && is_horizontal_blocked))
+                        continue;
+                }
+
+                admissible |= 1 << n_index;
+            }
+
+            admissible_neighbors[prevent_corner_crossing][walls] = admissible;
+        }
+    }
+}
+
+/**
+ * Sets the bits of the walls of the final floor field and of the ring around the environment in the wall bitboard.
+*/
+static void build_wall_bitboard()
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    memset(wall_bitboard, 0, sizeof(uint64_t) * (lines + 2) * bitboard_words_per_line);
+
+    for(int i = -1; i <= lines; i++)
+    {
+        for(int h = -1; h <= columns; h++)
+        {
+            bool is_ring = i == -1 || i == lines || h == -1 || h == columns;
+            if(is_ring || exits_set.final_floor_field[i][h] == WALL_VALUE)
+                set_bitboard_cell(wall_bitboard, i, h);
+        }
+    }
+}
+
+/**
+ * Sets the bits of the cells of the pedestrians still in the environment in the occupancy bitboard, which then matches pedestrian_position_grid.
+*/
+static void build_occupancy_bitboard()
+{
+    memset(occupancy_bitboard, 0, sizeof(uint64_t) * (cli_args.global_line_number + 2) * bitboard_words_per_line);
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state != GOT_OUT)
+            set_bitboard_cell(occupancy_bitboard, current_pedestrian->current.lin, current_pedestrian->current.col);
+    }
+}
+
+/**
+ * Sets the bit of the given cell.
+ *
+ * @param bitboard Bitboard to be written.
+ * @param line Line of the cell (from -1 to the number of lines).
+ * @param column Column of the cell (from -1 to the number of columns).
+*/
+static void set_bitboard_cell(uint64_t *bitboard, int line, int column)
+{
+    bitboard[(size_t) (line + 1) * bitboard_words_per_line + ((column + 1) >> 6)] |= (uint64_t) 1 << ((column + 1) & 63);
+}
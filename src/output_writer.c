@@ -0,0 +1,462 @@
+/*
+   File: output_writer.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module provides a faster path for the data written to the output stream. The stream receives a large user-space buffer, so that each flush results in a single write, and integers and fixed-precision numbers are formatted by hand and written without taking the stdio lock. The generated text is identical to the one produced by fprintf with the %d and %.Nlf conversions. Optionally, the writes are done by a separate thread: the output stream fills a pool of buffers and only hands off the index of each filled buffer through a bounded lock-free queue, so the simulations don't stall on a slow disk or pipe.
+*/
+
+#define _GNU_SOURCE // Required for fputs_unlocked and fopencookie.
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdint.h>
+#include<stdbool.h>
+#include<math.h>
+#include<unistd.h>
+#include<time.h>
+#include<pthread.h>
+#include<semaphore.h>
+#include<stdatomic.h>
+
+#include"../headers/output_writer.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    int buffer_indexes[ASYNC_OUTPUT_BUFFERS + 1]; // Room for every buffer of the pool and the termination index.
+    _Atomic int head; // Position of the next pop, only advanced by the consumer.
+    _Atomic int tail; // Position of the next push, only advanced by the producer.
+    sem_t available; // Number of indexes in the queue, used only to sleep while it is empty.
+} Buffer_Queue;
+
+static char output_buffer[OUTPUT_BUFFER_SIZE]; // Static, since stdout is never closed and keeps using it until the program ends.
+
+static FILE *async_stream = NULL; // Stream returned to the simulation while the writer thread runs.
+static FILE *async_destination = NULL; // Stream where the writer thread writes the filled buffers.
+static pthread_t writer_thread;
+static char *async_buffers[ASYNC_OUTPUT_BUFFERS];
+static size_t async_lengths[ASYNC_OUTPUT_BUFFERS];
+static Buffer_Queue filled_queue; // Buffers ready to be written, from the simulation to the writer thread.
+static Buffer_Queue free_queue; // Buffers already written, from the writer thread back to the simulation.
+static int current_buffer = -1; // Buffer being filled by the simulation.
+static bool async_write_error = false;
+
+static unsigned long handed_off_buffers = 0;
+static unsigned long long handed_off_bytes = 0;
+static unsigned long producer_stalls = 0; // Number of times the simulation waited for a free buffer.
+static double producer_stall_seconds = 0;
+static int maximum_queue_depth = 0;
+
+static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+static int format_unsigned(char *end, uint64_t value);
+static Function_Status start_async_writer(FILE **output_stream);
+static ssize_t async_cookie_write(void *cookie, const char *data, size_t size);
+static int async_cookie_close(void *cookie);
+static void hand_off_current_buffer();
+static void *write_filled_buffers(void *argument);
+static void push_buffer_index(Buffer_Queue *queue, int buffer_index);
+static int pop_buffer_index(Buffer_Queue *queue);
+static void close_async_writer_at_exit();
+
+/**
+ * Replaces the buffer of the output stream by a buffer of OUTPUT_BUFFER_SIZE bytes, in full buffering mode. With the --async-output option, the output stream is replaced by a stream whose buffers are written by a separate thread.
+ *
+ * @note Must be called before anything is written to the stream. Terminals keep their default buffering, so the visualization output format is still shown as it is generated.
+ * @note The asynchronous stream is also closed at the exit of the program, so the buffered data is written on every exit path.
+ *
+ * @param output_stream Pointer to the stream where the simulation data will be written.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status configure_output_buffer(FILE **output_stream)
+{
+    if(cli_args.async_output)
+        return start_async_writer(output_stream);
+
+    if(isatty(fileno(*output_stream)))
+        return SUCCESS;
+
+    if(setvbuf(*output_stream, output_buffer, _IOFBF, OUTPUT_BUFFER_SIZE) != 0)
+    {
+        fprintf(stderr, "It was not possible to configure the buffer of the output stream.\n");
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Writes everything written to the output stream so far, handing off the current buffer to the writer thread when the --async-output option is used. Called after each frame of the visualization output format, so the frames are shown as they are generated.
+ *
+ * @param output_stream Stream where the simulation data is written.
+*/
+void flush_output_stream(FILE *output_stream)
+{
+    if(output_stream == async_stream && async_stream != NULL)
+    {
+        if(async_lengths[current_buffer] > 0)
+            hand_off_current_buffer();
+    }
+    else
+        fflush(output_stream);
+}
+
+/**
+ * Writes the given text to the output stream, as fputs does.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param text Null-terminated string to be written.
+*/
+void write_text(FILE *output_stream, const char *text)
+{
+    fputs_unlocked(text, output_stream);
+}
+
+/**
+ * Writes an integer followed by the terminator character, as fprintf(output_stream, "%d%c", value, terminator) does.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param value Integer to be written.
+ * @param terminator Character written after the integer.
+*/
+void write_integer(FILE *output_stream, int value, char terminator)
+{
+    char digits[24];
+    char *end = digits + sizeof(digits);
+
+    *--end = terminator;
+    int length = format_unsigned(end, value < 0 ? -(uint64_t) value : (uint64_t) value) + 1;
+    if(value < 0)
+        digits[sizeof(digits) - ++length] = '-';
+
+    fwrite_unlocked(digits + sizeof(digits) - length, 1, length, output_stream);
+}
+
+/**
+ * Writes a number with a fixed number of decimal places followed by the terminator character, as fprintf(output_stream, "%.*lf%c", precision, value, terminator) does.
+ *
+ * @note Values too close to a rounding tie, too large, non-finite or with more than 9 decimal places are formatted by fprintf, so that the result is always identical to the one of fprintf.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param value Number to be written.
+ * @param precision Number of decimal places.
+ * @param terminator Character written after the number.
+*/
+void write_fixed(FILE *output_stream, double value, int precision, char terminator)
+{
+    char digits[48];
+    double scaled = 0, integral_part = 0, fraction = 0;
+
+    bool exact_formatting = precision >= 0 && precision <= 9 && fabs(value) < 1e15;
+    if(exact_formatting)
+    {
+        scaled = fabs(value) * powers_of_ten[precision];
+        integral_part = floor(scaled);
+        fraction = scaled - integral_part;
+
+        // The product may differ from the exact decimal value by a few units in the last place, so the exact rounding of
+        // fprintf is used near ties, as well as when the scaled value doesn't fit exactly in a double.
+        exact_formatting = scaled < 9e15 && fabs(fraction - 0.5) > scaled * 1e-15 + 1e-12;
+    }
+
+    if(! exact_formatting)
+    {
+        fprintf(output_stream, "%.*lf%c", precision, value, terminator);
+        return;
+    }
+
+    uint64_t rounded = (uint64_t) integral_part + (fraction > 0.5);
+    uint64_t divisor = (uint64_t) powers_of_ten[precision];
+
+    char *end = digits + sizeof(digits);
+    int length = 0;
+
+    *--end = terminator;
+    length++;
+
+    if(precision > 0)
+    {
+        uint64_t decimals = rounded % divisor;
+        for(int place = 0; place < precision; place++)
+        {
+            *--end = '0' + decimals % 10;
+            decimals /= 10;
+        }
+        *--end = '.';
+        length += precision + 1;
+    }
+
+    int integer_length = format_unsigned(end, rounded / divisor);
+    end -= integer_length;
+    length += integer_length;
+
+    if(signbit(value))
+    {
+        *--end = '-';
+        length++;
+    }
+
+    fwrite_unlocked(end, 1, length, output_stream);
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Writes the decimal digits of the given value right before the end pointer.
+ *
+ * @param end Position right after the last digit.
+ * @param value Value to be formatted.
+ * @return The number of written digits.
+*/
+static int format_unsigned(char *end, uint64_t value)
+{
+    int length = 0;
+
+    do
+    {
+        *--end = '0' + value % 10;
+        value /= 10;
+        length++;
+    }while(value != 0);
+
+    return length;
+}
+
+/**
+ * Replaces the output stream by an unbuffered stream that copies the data into the buffers of the pool, and starts the thread that writes the filled buffers to the original stream.
+ *
+ * @param output_stream Pointer to the output stream, which is replaced.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status start_async_writer(FILE **output_stream)
+{
+    sem_init(&filled_queue.available, 0, 0);
+    sem_init(&free_queue.available, 0, 0);
+
+    for(int buffer_index = 0; buffer_index < ASYNC_OUTPUT_BUFFERS; buffer_index++)
+    {
+        async_buffers[buffer_index] = malloc(OUTPUT_BUFFER_SIZE);
+        if(async_buffers[buffer_index] == NULL)
+        {
+            fprintf(stderr, "Failure during the allocation of the asynchronous output buffers.\n");
+            return FAILURE;
+        }
+
+        if(buffer_index > 0)
+            push_buffer_index(&free_queue, buffer_index);
+    }
+
+    current_buffer = 0;
+    async_lengths[current_buffer] = 0;
+    async_destination = *output_stream;
+
+    if(pthread_create(&writer_thread, NULL, write_filled_buffers, NULL) != 0)
+    {
+        fprintf(stderr, "It was not possible to start the output writer thread.\n");
+        return FAILURE;
+    }
+
+    cookie_io_functions_t async_functions = {.write = async_cookie_write, .close = async_cookie_close};
+    async_stream = fopencookie(NULL, "w", async_functions);
+    if(async_stream == NULL || setvbuf(async_stream, NULL, _IONBF, 0) != 0)
+    {
+        fprintf(stderr, "It was not possible to create the asynchronous output stream.\n");
+        if(async_stream != NULL)
+            fclose(async_stream); // Also stops the writer thread.
+        else
+        {
+            push_buffer_index(&filled_queue, -1);
+            pthread_join(writer_thread, NULL);
+        }
+        async_stream = NULL;
+        return FAILURE;
+    }
+
+    atexit(close_async_writer_at_exit);
+    *output_stream = async_stream;
+
+    return SUCCESS;
+}
+
+/**
+ * Called by stdio for every write to the asynchronous stream. Copies the data into the current buffer, handing it off to the writer thread whenever it is filled.
+ *
+ * @param cookie Unused.
+ * @param data Data to be written.
+ * @param size Number of bytes of data.
+ * @return The number of bytes consumed, which is always size.
+*/
+static ssize_t async_cookie_write(void *cookie, const char *data, size_t size)
+{
+    (void) cookie;
+
+    size_t consumed = 0;
+
+    while(consumed < size)
+    {
+        size_t space = OUTPUT_BUFFER_SIZE - async_lengths[current_buffer];
+        size_t chunk = size - consumed < space ? size - consumed : space;
+
+        memcpy(async_buffers[current_buffer] + async_lengths[current_buffer], data + consumed, chunk);
+        async_lengths[current_buffer] += chunk;
+        consumed += chunk;
+
+        if(async_lengths[current_buffer] == OUTPUT_BUFFER_SIZE)
+            hand_off_current_buffer();
+    }
+
+    return size;
+}
+
+/**
+ * Called by stdio when the asynchronous stream is closed. Hands off the last buffer, waits for the writer thread to finish, closes the original stream and prints the back-pressure metrics to stderr.
+ *
+ * @param cookie Unused.
+ * @return 0 on success or EOF if any write failed.
+*/
+static int async_cookie_close(void *cookie)
+{
+    (void) cookie;
+
+    if(async_lengths[current_buffer] > 0)
+        hand_off_current_buffer();
+
+    push_buffer_index(&filled_queue, -1); // Tells the writer thread to finish.
+    pthread_join(writer_thread, NULL);
+
+    if(async_destination != stdout)
+    {
+        if(fclose(async_destination) != 0)
+            async_write_error = true;
+    }
+    else if(fflush(stdout) != 0)
+        async_write_error = true;
+
+    fprintf(stderr, "Asynchronous output: %lu buffers (%.1lf MiB) written; the simulation waited %lu times for a free buffer (%.3lf s in total); maximum queue depth of %d/%d.\n",
+            handed_off_buffers, handed_off_bytes / (1024.0 * 1024.0), producer_stalls, producer_stall_seconds, maximum_queue_depth, ASYNC_OUTPUT_BUFFERS);
+
+    for(int buffer_index = 0; buffer_index < ASYNC_OUTPUT_BUFFERS; buffer_index++)
+    {
+        free(async_buffers[buffer_index]);
+        async_buffers[buffer_index] = NULL;
+    }
+
+    sem_destroy(&filled_queue.available);
+    sem_destroy(&free_queue.available);
+    async_stream = NULL;
+    async_destination = NULL;
+    current_buffer = -1;
+
+    if(async_write_error)
+    {
+        fprintf(stderr, "The writer thread failed to write the output file.\n");
+        return EOF;
+    }
+
+    return 0;
+}
+
+/**
+ * Hands off the current buffer to the writer thread and takes a free buffer, waiting for one if all of them are queued.
+*/
+static void hand_off_current_buffer()
+{
+    handed_off_buffers++;
+    handed_off_bytes += async_lengths[current_buffer];
+    push_buffer_index(&filled_queue, current_buffer);
+
+    int queue_depth = (atomic_load(&filled_queue.tail) - atomic_load(&filled_queue.head) + ASYNC_OUTPUT_BUFFERS + 1) % (ASYNC_OUTPUT_BUFFERS + 1);
+    if(queue_depth > maximum_queue_depth)
+        maximum_queue_depth = queue_depth;
+
+    if(sem_trywait(&free_queue.available) != 0)
+    {
+        struct timespec start, end;
+
+        producer_stalls++;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        while(sem_wait(&free_queue.available) != 0); // Retries when interrupted by a signal.
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        producer_stall_seconds += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    }
+
+    current_buffer = pop_buffer_index(&free_queue);
+    async_lengths[current_buffer] = 0;
+}
+
+/**
+ * Body of the writer thread: writes each filled buffer to the original stream and returns it to the pool, until the termination index (-1) is received.
+ *
+ * @param argument Unused.
+ * @return NULL.
+*/
+static void *write_filled_buffers(void *argument)
+{
+    (void) argument;
+
+    while(true)
+    {
+        while(sem_wait(&filled_queue.available) != 0);
+
+        int buffer_index = pop_buffer_index(&filled_queue);
+        if(buffer_index == -1)
+            break;
+
+        // The original stream may itself be a compressed stream, in which case the compression also runs in this thread.
+        if(! async_write_error && fwrite(async_buffers[buffer_index], 1, async_lengths[buffer_index], async_destination) != async_lengths[buffer_index])
+            async_write_error = true;
+
+        push_buffer_index(&free_queue, buffer_index);
+    }
+
+    return NULL;
+}
+
+/**
+ * Pushes a buffer index to a single-producer single-consumer queue and wakes up its consumer.
+ *
+ * @note The queue never overflows, as it can hold every buffer of the pool plus the termination index, which is only pushed after all buffers were returned or queued.
+ *
+ * @param queue Queue that receives the index.
+ * @param buffer_index Index of the buffer (or -1 to finish the writer thread).
+*/
+static void push_buffer_index(Buffer_Queue *queue, int buffer_index)
+{
+    int tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    queue->buffer_indexes[tail] = buffer_index;
+    atomic_store_explicit(&queue->tail, (tail + 1) % (ASYNC_OUTPUT_BUFFERS + 1), memory_order_release);
+
+    sem_post(&queue->available);
+}
+
+/**
+ * Pops a buffer index from a single-producer single-consumer queue.
+ *
+ * @note Must only be called after a successful wait on the available semaphore of the queue, which guarantees that the index was already pushed.
+ *
+ * @param queue Queue from which the index is taken.
+ * @return The index of the buffer (or -1 to finish the writer thread).
+*/
+static int pop_buffer_index(Buffer_Queue *queue)
+{
+    int head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    int buffer_index = queue->buffer_indexes[head];
+    atomic_store_explicit(&queue->head, (head + 1) % (ASYNC_OUTPUT_BUFFERS + 1), memory_order_release);
+
+    return buffer_index;
+}
+
+/**
+ * Closes the asynchronous stream if the program ends without closing it (e.g. after an error), so the buffered data is handed off and written, and the writer thread is joined.
+*/
+static void close_async_writer_at_exit()
+{
+    if(async_stream != NULL)
+        fclose(async_stream);
+}
@@ -0,0 +1,218 @@
+/*
+   File: parallel_field.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module calculates the static weights of a single exit with several threads, for very large environments. The grid lines are split in bands, one for each thread, and every sweep of calculate_static_weight becomes a parallel wavefront: each cell takes the lowest value offered by its neighbors in the previous sweep, so the threads never write to the same cell. Lines whose neighborhood didn't change in the previous sweep are skipped, since their values can't change either. The threads are synchronized by a barrier at the end of each sweep, and the results are identical to those of calculate_static_weight.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+#include<pthread.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/parallel_field.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+typedef struct Field_Context Field_Context;
+
+typedef struct{
+    Field_Context *context;
+    pthread_t thread;
+    int first_line; // First line of the band.
+    int last_line; // Line just after the last line of the band.
+    bool has_changed[2]; // Indicates if any value of the band changed in the last sweep that wrote to the grid of the same index.
+} Field_Band;
+
+struct Field_Context{
+    Double_Grid grids[2]; // The sweeps read from one grid and write to the other, alternately.
+    bool *line_changed[2]; // Indicates, for each line, if any of its values changed in the sweep that wrote to the grid of the same index.
+    double floor_field_rule[3][3];
+    pthread_mutex_t start_lock;
+    pthread_barrier_t barrier;
+    Field_Band *bands;
+    int num_bands;
+};
+
+static void *propagate_band(void *band_pointer);
+static bool relax_line(Field_Context *context, Double_Grid static_weight, Double_Grid auxiliary_grid, int line);
+
+/**
+ * Calculates the static weights for the given exit with cli_args.num_threads threads. The static weight grid must be already initialized, as in calculate_static_weight.
+ *
+ * @param current_exit Exit for which the static weights will be calculated.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status calculate_parallel_static_weight(Exit current_exit)
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+    int num_bands = cli_args.num_threads < lines ? cli_args.num_threads : lines;
+
+    Field_Context context = {
+        .grids = {current_exit->static_weight, allocate_double_grid(lines, columns)},
+        .line_changed = {malloc(sizeof(bool) * lines), malloc(sizeof(bool) * lines)},
+        .floor_field_rule = {{cli_args.diagonal,    1.0,    cli_args.diagonal},
+                             {       1.0,           0.0,           1.0       },
+                             {cli_args.diagonal,    1.0,    cli_args.diagonal}},
+        .bands = malloc(sizeof(Field_Band) * num_bands),
+        .start_lock = PTHREAD_MUTEX_INITIALIZER,
+        .num_bands = num_bands
+    };
+
+    Function_Status status = SUCCESS;
+    if(context.grids[1] == NULL || context.line_changed[0] == NULL || context.line_changed[1] == NULL || context.bands == NULL)
+    {
+        fprintf(stderr, "Failure to allocate the structures at calculate_parallel_static_weight.\n");
+        status = FAILURE;
+        goto cleanup;
+    }
+
+    for(int i = 0; i < lines; i++)
+        context.line_changed[0][i] = true; // The first sweep visits every line.
+
+    for(int band_index = 0; band_index < num_bands; band_index++)
+        context.bands[band_index].context = &context;
+
+    // The threads wait at the start lock until the bands are split between the threads that were actually started.
+    pthread_mutex_lock(&context.start_lock);
+
+    int num_started_threads = 0;
+    for(int band_index = 1; band_index < num_bands; band_index++)
+    {
+        if(pthread_create(&context.bands[band_index].thread, NULL, propagate_band, &context.bands[band_index]) != 0)
+            break;
+        num_started_threads++;
+    }
+
+    context.num_bands = num_started_threads + 1; // The calling thread takes the first band.
+    for(int band_index = 0; band_index < context.num_bands; band_index++)
+    {
+        Field_Band *band = &context.bands[band_index];
+        band->first_line = (int) ((long long) lines * band_index / context.num_bands);
+        band->last_line = (int) ((long long) lines * (band_index + 1) / context.num_bands);
+        band->has_changed[0] = band->has_changed[1] = false;
+    }
+    pthread_barrier_init(&context.barrier, NULL, context.num_bands);
+
+    pthread_mutex_unlock(&context.start_lock);
+
+    propagate_band(&context.bands[0]);
+
+    for(int band_index = 1; band_index < context.num_bands; band_index++)
+        pthread_join(context.bands[band_index].thread, NULL);
+
+    pthread_barrier_destroy(&context.barrier);
+
+    // The last sweep didn't change any value, so both grids hold the same weights.
+
+cleanup:
+    deallocate_grid((void **) context.grids[1], lines);
+    free(context.line_changed[0]);
+    free(context.line_changed[1]);
+    free(context.bands);
+
+    return status;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Body of the thread of each band: sweeps the lines of the band until a sweep doesn't change any value of the grid.
+ *
+ * @param band_pointer Pointer to the Field_Band processed by the thread.
+ * @return Always NULL.
+*/
+static void *propagate_band(void *band_pointer)
+{
+    Field_Band *band = band_pointer;
+    Field_Context *context = band->context;
+
+    pthread_mutex_lock(&context->start_lock);
+    pthread_mutex_unlock(&context->start_lock);
+
+    int lines = cli_args.global_line_number;
+
+    for(int sweep = 0; ; sweep++)
+    {
+        int current = sweep % 2, next = 1 - current;
+        bool *was_changed = context->line_changed[current];
+        bool *is_changed = context->line_changed[next];
+
+        band->has_changed[next] = false;
+        for(int i = band->first_line; i < band->last_line; i++)
+        {
+            bool is_affected = was_changed[i] || (i > 0 && was_changed[i - 1]) || (i < lines - 1 && was_changed[i + 1]);
+
+            // An unaffected line kept its values in the previous sweep, so both grids already hold them.
+            is_changed[i] = is_affected && relax_line(context, context->grids[current], context->grids[next], i);
+            band->has_changed[next] |= is_changed[i];
+        }
+
+        pthread_barrier_wait(&context->barrier);
+
+        bool has_changed = false;
+        for(int band_index = 0; band_index < context->num_bands; band_index++)
+            has_changed |= context->bands[band_index].has_changed[next];
+
+        if(has_changed == false)
+            break;
+    }
+
+    return NULL;
+}
+
+/**
+ * Calculates the values of a line for the next sweep. Instead of each cell lowering the values of its neighbors, as in calculate_static_weight, each cell takes the lowest value offered by its neighbors, with the same rules. Since the lowest value doesn't depend on the order of the neighbors, the results are the same.
+ *
+ * @param context Context of the calculation.
+ * @param static_weight Grid with the values of the previous sweep.
+ * @param auxiliary_grid Grid where the values of the next sweep will be stored.
+ * @param line Line to be calculated.
+ * @return bool, where True indicates that at least one value of the line changed.
+*/
+static bool relax_line(Field_Context *context, Double_Grid static_weight, Double_Grid auxiliary_grid, int line)
+{
+    bool has_changed = false;
+
+    for(int h = 0; h < cli_args.global_column_number; h++)
+    {
+        double current_cell_value = static_weight[line][h];
+        double new_value = current_cell_value;
+
+        if(current_cell_value != WALL_VALUE && current_cell_value != EXIT_VALUE)
+        {
+            // (j, k) is the direction of the movement from the neighbor to the current cell.
+            for(int j = -1; j < 2; j++)
+            {
+                if(! is_within_grid_lines(line - j))
+                    continue;
+
+                for(int k = -1; k < 2; k++)
+                {
+                    if(! is_within_grid_columns(h - k) || (j == 0 && k == 0))
+                        continue;
+
+                    double neighbor_value = static_weight[line - j][h - k];
+                    if(neighbor_value == WALL_VALUE || neighbor_value == 0.0) // floor field calculations occur only on cells with values
+                        continue;
+
+                    if(j != 0 && k != 0 && ! is_diagonal_valid((Location){line - j, h - k}, (Location){j, k}, static_weight))
+                        continue;
+
+                    double offered_value = neighbor_value + context->floor_field_rule[1 + j][1 + k];
+                    if(new_value == 0.0 || offered_value < new_value)
+                        new_value = offered_value;
+                }
+            }
+        }
+
+        auxiliary_grid[line][h] = new_value;
+        has_changed |= new_value != current_cell_value;
+    }
+
+    return has_changed;
+}
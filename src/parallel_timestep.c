@@ -0,0 +1,512 @@
+/*
+   File: parallel_timestep.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module runs the movement part of a timestep (movement evaluation, panic, X movements, conflicts and the movement itself) with the threads of the thread pool, for very large crowds. The environment lines are split in bands and each band processes the pedestrians located on its lines. Target cells are claimed with an atomic compare-and-swap on a claim grid, which keeps the lowest id among the pedestrians that target each cell; that pedestrian solves the conflict of the cell, drawing from its own substream, as in solve_pedestrian_conflicts. The X movements are detected by each band and solved in the scanning order of block_X_movement. Since every random draw comes from the substream of a pedestrian (the --common-random-numbers option), the results are identical to those of the sequential timestep, whatever the number of threads.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+#include<stdatomic.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/heatmap.h"
+#include"../headers/pedestrian.h"
+#include"../headers/thread_pool.h"
+#include"../headers/random_stream.h"
+#include"../headers/cli_processing.h"
+#include"../headers/parallel_timestep.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    int first_id; // Pedestrian whose path crosses the path of at least one of the neighbors below.
+    int right_id; // Pedestrian at the right of the first one, if their paths cross (0 otherwise).
+    int down_id; // Pedestrian below the first one, if their paths cross (0 otherwise).
+} X_Candidate;
+
+typedef struct{
+    int first_line; // First line of the band.
+    int last_line; // Line just after the last line of the band.
+    int *pedestrian_indexes; // Indexes of the pedestrians located on the lines of the band, in increasing order.
+    int num_pedestrians;
+    X_Candidate *x_candidates; // Possible X movements found on the lines of the band, in the scanning order.
+    int num_x_candidates;
+    int x_candidates_capacity;
+} Timestep_Band;
+
+static Timestep_Band *timestep_bands = NULL;
+static int num_timestep_bands = 0;
+static int *line_bands = NULL; // Band of each line.
+static int *band_pedestrian_indexes = NULL; // Storage of the pedestrian_indexes of every band.
+static bool *is_claiming = NULL; // Indicates, for each pedestrian index, if the pedestrian claimed its target cell in the current timestep.
+static int pedestrians_capacity = 0;
+static atomic_int *claim_grid = NULL; // Lowest id among the pedestrians that claimed each cell (0 if none), indexed by line * columns + column.
+
+static Function_Status allocate_parallel_timestep();
+static Function_Status distribute_pedestrians();
+static Function_Status evaluate_band_movements(int band_index);
+static Function_Status find_band_x_candidates(int band_index);
+static void solve_x_candidates();
+static Function_Status claim_band_targets(int band_index);
+static Function_Status solve_band_conflicts(int band_index);
+static Function_Status move_band_pedestrians(int band_index);
+static Function_Status place_band_pedestrians(int band_index);
+static Function_Status run_band_phase(Pool_Task phase);
+
+/**
+ * Calculates the number of bands in which the environment lines are split for the parallel timestep.
+ *
+ * @return An integer, indicating the number of bands.
+*/
+int get_timestep_band_quantity()
+{
+    return cli_args.num_threads < cli_args.global_line_number ? cli_args.num_threads : cli_args.global_line_number;
+}
+
+/**
+ * Runs the movement part of a timestep in parallel, replacing the sequence evaluate_pedestrians_movements, determine_pedestrians_in_panic, block_X_movement, conflict solving, apply_pedestrian_movement, update_pedestrian_position_grid, reset_pedestrian_state and reset_pedestrian_panic.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_parallel_timestep()
+{
+    if(timestep_bands == NULL && allocate_parallel_timestep() == FAILURE)
+        return FAILURE;
+
+    if(distribute_pedestrians() == FAILURE)
+        return FAILURE;
+
+    if(run_band_phase(evaluate_band_movements) == FAILURE)
+        return FAILURE;
+
+    if(! cli_args.allow_X_movement)
+    {
+        if(run_band_phase(find_band_x_candidates) == FAILURE)
+            return FAILURE;
+
+        solve_x_candidates();
+    }
+
+    if(run_band_phase(claim_band_targets) == FAILURE || run_band_phase(solve_band_conflicts) == FAILURE)
+        return FAILURE;
+
+    // The position grid is cleared by every band before any band places its pedestrians at their new locations.
+    if(run_band_phase(move_band_pedestrians) == FAILURE || run_band_phase(place_band_pedestrians) == FAILURE)
+        return FAILURE;
+
+    set_heatmap_worker(0);
+
+    return SUCCESS;
+}
+
+/**
+ * Deallocates the structures of the parallel timestep.
+*/
+void deallocate_parallel_timestep()
+{
+    for(int band_index = 0; band_index < num_timestep_bands; band_index++)
+        free(timestep_bands[band_index].x_candidates);
+
+    free(timestep_bands);
+    free(line_bands);
+    free(band_pedestrian_indexes);
+    free(is_claiming);
+    free(claim_grid);
+
+    timestep_bands = NULL;
+    line_bands = NULL;
+    band_pedestrian_indexes = NULL;
+    is_claiming = NULL;
+    claim_grid = NULL;
+    num_timestep_bands = 0;
+    pedestrians_capacity = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Allocates the bands, which split the environment lines evenly, and the claim grid.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status allocate_parallel_timestep()
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    num_timestep_bands = get_timestep_band_quantity();
+    timestep_bands = calloc(num_timestep_bands, sizeof(Timestep_Band));
+    line_bands = malloc(sizeof(int) * lines);
+    claim_grid = calloc((size_t) lines * columns, sizeof(atomic_int));
+    if(timestep_bands == NULL || line_bands == NULL || claim_grid == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the parallel timestep structures.\n");
+        return FAILURE;
+    }
+
+    for(int band_index = 0; band_index < num_timestep_bands; band_index++)
+    {
+        Timestep_Band *band = &timestep_bands[band_index];
+        band->first_line = (int) ((long long) lines * band_index / num_timestep_bands);
+        band->last_line = (int) ((long long) lines * (band_index + 1) / num_timestep_bands);
+
+        for(int i = band->first_line; i < band->last_line; i++)
+            line_bands[i] = band_index;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Distributes the pedestrians still in the environment between the bands, according to their current lines. The pedestrians of each band keep the order of the pedestrian_set.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status distribute_pedestrians()
+{
+    int num_pedestrians = pedestrian_set.num_pedestrians;
+
+    if(num_pedestrians > pedestrians_capacity)
+    {
+        int *new_indexes = realloc(band_pedestrian_indexes, sizeof(int) * num_pedestrians);
+        bool *new_claims = realloc(is_claiming, sizeof(bool) * num_pedestrians);
+        if(new_indexes != NULL)
+            band_pedestrian_indexes = new_indexes;
+        if(new_claims != NULL)
+            is_claiming = new_claims;
+
+        if(new_indexes == NULL || new_claims == NULL)
+        {
+            fprintf(stderr, "Failure in the realloc of the parallel timestep pedestrian lists.\n");
+            return FAILURE;
+        }
+
+        pedestrians_capacity = num_pedestrians;
+    }
+
+    // The substreams can't grow while the bands draw from them.
+    if(reserve_random_streams(num_pedestrians) == FAILURE)
+        return FAILURE;
+
+    for(int band_index = 0; band_index < num_timestep_bands; band_index++)
+        timestep_bands[band_index].num_pedestrians = 0;
+
+    for(int p_index = 0; p_index < num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state != GOT_OUT)
+            timestep_bands[line_bands[current_pedestrian->current.lin]].num_pedestrians++;
+    }
+
+    int first_position = 0;
+    for(int band_index = 0; band_index < num_timestep_bands; band_index++)
+    {
+        Timestep_Band *band = &timestep_bands[band_index];
+        band->pedestrian_indexes = band_pedestrian_indexes + first_position;
+        first_position += band->num_pedestrians;
+        band->num_pedestrians = 0;
+    }
+
+    for(int p_index = 0; p_index < num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state == GOT_OUT)
+            continue;
+
+        Timestep_Band *band = &timestep_bands[line_bands[current_pedestrian->current.lin]];
+        band->pedestrian_indexes[band->num_pedestrians++] = p_index;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Determines the destination cell of each pedestrian of the band, followed by the panic state. Each pedestrian only reads the grids, which don't change in this phase, and draws from its own substreams.
+ *
+ * @param band_index Index of the band.
+ * @return Function_Status: SUCCESS (1).
+*/
+static Function_Status evaluate_band_movements(int band_index)
+{
+    Timestep_Band *band = &timestep_bands[band_index];
+
+    for(int position = 0; position < band->num_pedestrians; position++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[band->pedestrian_indexes[position]];
+
+        evaluate_pedestrian_movement(current_pedestrian);
+        determine_pedestrian_panic(current_pedestrian);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Scans the lines of the band like block_X_movement, storing the pairs of adjacent pedestrians whose paths cross. The pairs are only solved later, in the scanning order, since solving a pair may stop a pedestrian of another pair.
+ *
+ * @param band_index Index of the band.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status find_band_x_candidates(int band_index)
+{
+    Timestep_Band *band = &timestep_bands[band_index];
+    band->num_x_candidates = 0;
+
+    int first_line = band->first_line > 1 ? band->first_line : 1;
+    int last_line = band->last_line < cli_args.global_line_number - 1 ? band->last_line : cli_args.global_line_number - 1;
+
+    for(int i = first_line; i < last_line; i++)
+    {
+        for(int h = 1; h < cli_args.global_column_number - 1; h++)
+        {
+            int first_pedestrian_id = pedestrian_position_grid[i][h];
+            if(first_pedestrian_id <= 0)
+                continue;
+
+            Pedestrian first_pedestrian = pedestrian_set.list[first_pedestrian_id - 1];
+            if(first_pedestrian->state != MOVING || first_pedestrian->in_panic == true)
+                continue;
+
+            X_Candidate candidate = {first_pedestrian_id, pedestrian_position_grid[i][h + 1], pedestrian_position_grid[i + 1][h]};
+
+            if(candidate.right_id > 0 && ! are_pedestrian_paths_crossing(first_pedestrian, pedestrian_set.list[candidate.right_id - 1]))
+                candidate.right_id = 0;
+
+            if(candidate.down_id > 0 && ! are_pedestrian_paths_crossing(first_pedestrian, pedestrian_set.list[candidate.down_id - 1]))
+                candidate.down_id = 0;
+
+            if(candidate.right_id <= 0 && candidate.down_id <= 0)
+                continue;
+
+            if(band->num_x_candidates == band->x_candidates_capacity)
+            {
+                int new_capacity = band->x_candidates_capacity == 0 ? 16 : band->x_candidates_capacity * 2;
+                X_Candidate *new_candidates = realloc(band->x_candidates, sizeof(X_Candidate) * new_capacity);
+                if(new_candidates == NULL)
+                {
+                    fprintf(stderr, "Failure in the realloc of the X movement candidates.\n");
+                    return FAILURE;
+                }
+
+                band->x_candidates = new_candidates;
+                band->x_candidates_capacity = new_capacity;
+            }
+
+            band->x_candidates[band->num_x_candidates++] = candidate;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Solves the X movements found by the bands, in the scanning order of block_X_movement. The paths of a pair only cross if both pedestrians are still moving, since the states only change from MOVING to STOPPED while the X movements are solved.
+*/
+static void solve_x_candidates()
+{
+    for(int band_index = 0; band_index < num_timestep_bands; band_index++)
+    {
+        Timestep_Band *band = &timestep_bands[band_index];
+
+        for(int candidate_index = 0; candidate_index < band->num_x_candidates; candidate_index++)
+        {
+            X_Candidate candidate = band->x_candidates[candidate_index];
+            Pedestrian first_pedestrian = pedestrian_set.list[candidate.first_id - 1];
+
+            if(first_pedestrian->state != MOVING)
+                continue;
+
+            if(candidate.right_id > 0 && pedestrian_set.list[candidate.right_id - 1]->state == MOVING)
+            {
+                solve_X_movement(first_pedestrian, pedestrian_set.list[candidate.right_id - 1]);
+                continue;
+            }
+
+            if(candidate.down_id > 0 && pedestrian_set.list[candidate.down_id - 1]->state == MOVING)
+                solve_X_movement(first_pedestrian, pedestrian_set.list[candidate.down_id - 1]);
+        }
+    }
+}
+
+/**
+ * Each moving pedestrian of the band claims its target cell, which keeps the lowest id among its claimers.
+ *
+ * @param band_index Index of the band.
+ * @return Function_Status: SUCCESS (1).
+*/
+static Function_Status claim_band_targets(int band_index)
+{
+    Timestep_Band *band = &timestep_bands[band_index];
+
+    for(int position = 0; position < band->num_pedestrians; position++)
+    {
+        int p_index = band->pedestrian_indexes[position];
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+
+        is_claiming[p_index] = current_pedestrian->state == MOVING && current_pedestrian->in_panic == false;
+        if(is_claiming[p_index] == false)
+            continue;
+
+        atomic_int *claimed_cell = &claim_grid[current_pedestrian->target.lin * cli_args.global_column_number + current_pedestrian->target.col];
+        int claimer_id = atomic_load_explicit(claimed_cell, memory_order_relaxed);
+
+        while((claimer_id == 0 || current_pedestrian->id < claimer_id) &&
+              ! atomic_compare_exchange_weak_explicit(claimed_cell, &claimer_id, current_pedestrian->id, memory_order_relaxed, memory_order_relaxed));
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Solves the conflicts of the cells claimed by the pedestrians of the band with the lowest id. The other claimers of the cell are within its neighborhood and are listed in increasing order of id, as in identify_pedestrian_conflicts, and the winner is drawn from the substream of the lowest id, as in solve_pedestrian_conflicts.
+ *
+ * @param band_index Index of the band.
+ * @return Function_Status: SUCCESS (1).
+*/
+static Function_Status solve_band_conflicts(int band_index)
+{
+    Timestep_Band *band = &timestep_bands[band_index];
+
+    for(int position = 0; position < band->num_pedestrians; position++)
+    {
+        int p_index = band->pedestrian_indexes[position];
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+
+        if(is_claiming[p_index] == false)
+            continue;
+
+        Location target = current_pedestrian->target;
+        if(atomic_load_explicit(&claim_grid[target.lin * cli_args.global_column_number + target.col], memory_order_relaxed) != current_pedestrian->id)
+            continue;
+
+        int pedestrian_ids[9];
+        int num_pedestrians = 0;
+
+        for(int j = -1; j < 2; j++)
+        {
+            if(! is_within_grid_lines(target.lin + j))
+                continue;
+
+            for(int k = -1; k < 2; k++)
+            {
+                if(! is_within_grid_columns(target.col + k))
+                    continue;
+
+                int neighbor_id = pedestrian_position_grid[target.lin + j][target.col + k];
+                if(neighbor_id <= 0 || is_claiming[neighbor_id - 1] == false)
+                    continue;
+
+                Location neighbor_target = pedestrian_set.list[neighbor_id - 1]->target;
+                if(neighbor_target.lin != target.lin || neighbor_target.col != target.col)
+                    continue;
+
+                // Insertion in increasing order of id.
+                int insert_position = num_pedestrians++;
+                while(insert_position > 0 && pedestrian_ids[insert_position - 1] > neighbor_id)
+                {
+                    pedestrian_ids[insert_position] = pedestrian_ids[insert_position - 1];
+                    insert_position--;
+                }
+                pedestrian_ids[insert_position] = neighbor_id;
+            }
+        }
+
+        if(num_pedestrians < 2)
+            continue;
+
+        int random_result = draw_random_integer(pedestrian_ids[0], CONFLICT_STREAM, num_pedestrians);
+        for(int conflict_index = 0; conflict_index < num_pedestrians; conflict_index++)
+        {
+            if(conflict_index != random_result)
+                pedestrian_set.list[pedestrian_ids[conflict_index] - 1]->state = STOPPED;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Moves the pedestrians of the band, releases their claims and clears the lines of the band in the position grid.
+ *
+ * @param band_index Index of the band.
+ * @return Function_Status: SUCCESS (1).
+*/
+static Function_Status move_band_pedestrians(int band_index)
+{
+    Timestep_Band *band = &timestep_bands[band_index];
+
+    for(int position = 0; position < band->num_pedestrians; position++)
+    {
+        int p_index = band->pedestrian_indexes[position];
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+
+        if(is_claiming[p_index] == true)
+        {
+            Location target = current_pedestrian->target;
+            atomic_store_explicit(&claim_grid[target.lin * cli_args.global_column_number + target.col], 0, memory_order_relaxed);
+        }
+
+        move_pedestrian(current_pedestrian);
+    }
+
+    for(int i = band->first_line; i < band->last_line; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+            pedestrian_position_grid[i][h] = 0;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Places the pedestrians of the band at their new locations in the position grid, recording the heatmap visits in the accumulator of the band, and resets their states and panic flags, as in update_pedestrian_position_grid, reset_pedestrian_state and reset_pedestrian_panic.
+ *
+ * @param band_index Index of the band.
+ * @return Function_Status: SUCCESS (1).
+*/
+static Function_Status place_band_pedestrians(int band_index)
+{
+    Timestep_Band *band = &timestep_bands[band_index];
+
+    set_heatmap_worker(band_index);
+
+    for(int position = 0; position < band->num_pedestrians; position++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[band->pedestrian_indexes[position]];
+
+        if(current_pedestrian->state == GOT_OUT)
+            continue;
+
+        pedestrian_position_grid[current_pedestrian->current.lin][current_pedestrian->current.col] = current_pedestrian->id;
+        record_heatmap_visit(current_pedestrian->current);
+
+        if(current_pedestrian->state != LEAVING)
+            current_pedestrian->state = MOVING;
+        current_pedestrian->in_panic = false;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Runs a phase of the timestep for every band on the thread pool. The next phase only starts after every band finishes the current one.
+ *
+ * @param phase Function called with the index of each band.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status run_band_phase(Pool_Task phase)
+{
+    Function_Status band_statuses[num_timestep_bands];
+    run_pool_tasks(phase, num_timestep_bands, band_statuses);
+
+    for(int band_index = 0; band_index < num_timestep_bands; band_index++)
+    {
+        if(band_statuses[band_index] == FAILURE)
+            return FAILURE;
+    }
+
+    return SUCCESS;
+}
@@ -9,40 +9,33 @@
 #include<stdlib.h>
 #include<stdbool.h>
 #include<math.h>
+#include<float.h>
 
 #include"../headers/cell.h"
 #include"../headers/exit.h"
 #include"../headers/grid.h"
+#include"../headers/heatmap.h"
 #include"../headers/pedestrian.h"
+#include"../headers/placement.h"
+#include"../headers/random_stream.h"
 #include"../headers/cli_processing.h"
 #include"../headers/shared_resources.h"
 
-#define PANIC_PROBABILITY 0.05
-
 typedef struct reduced_line_equation{
     double angular_coefficient;
     double linear_coefficient; // Where the line intersects the y-axis.
 }reduced_line_equation;
 
-typedef struct cell_conflict{
-    int num_pedestrians;
-    int pedestrian_ids[8];
-    int pedestrian_allowed;
-}cell_conflict;
-
 Pedestrian_Set pedestrian_set = {NULL,0};
 
 static Pedestrian create_pedestrian(Location ped_coordinates);
-static bool are_pedestrian_paths_crossing(Pedestrian first_pedestrian, Pedestrian second_pedestrian);
 static Function_Status calculate_reduced_line_equation(Location origin, Location target, reduced_line_equation* line);
 static void calculate_intersection_point(reduced_line_equation first_line, reduced_line_equation second_line, double *x, double *y);
 static bool is_intersection_within_pedestrian_movement(double x_coordinate, double y_coordinate, Pedestrian pedestrian);
-static void solve_X_movement(Pedestrian first_pedestrian, Pedestrian second_pedestrian);
+static Function_Status conflict_solving();
 
 /**
- * Inserts a specified number of pedestrians at random locations within the environment.
- * 
- * @note This function does not handle cases where there is insufficient space to insert all pedestrians.
+ * Inserts a specified number of pedestrians at random locations within the environment, drawn among its free cells (inside the spawn zones, if given).
  * 
  * @param num_pedestrians_to_insert Number of pedestrians to insert in the environment.
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
@@ -58,25 +51,34 @@ Function_Status insert_pedestrians_at_random(int num_pedestrians_to_insert)
     if(reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number) == FAILURE)
         return FAILURE;
 
-    for(int p_index = 0; p_index < num_pedestrians_to_insert;)
+    Location *random_coordinates = malloc(sizeof(Location) * num_pedestrians_to_insert);
+    if(random_coordinates == NULL)
     {
-        int line = rand() % (cli_args.global_line_number - 1) + 1;
-        int column = rand() % (cli_args.global_column_number - 1) + 1;
-
-        Location random_coordinates = {line,column};
+        fprintf(stderr, "Failure during the allocation of the coordinates of the pedestrians.\n");
+        return FAILURE;
+    }
 
-        if(pedestrian_position_grid[line][column] != 0 || exits_set.final_floor_field[line][column] == EXIT_VALUE 
-            || exits_set.final_floor_field[line][column] == WALL_VALUE)
-            continue;
+    // The cell of each pedestrian is drawn from their placement substream before they are created.
+    if(reserve_random_streams(num_pedestrians_to_insert) == FAILURE || draw_placement_cells(num_pedestrians_to_insert, random_coordinates) == FAILURE)
+    {
+        free(random_coordinates);
+        return FAILURE;
+    }
 
-        if( add_new_pedestrian(random_coordinates) == FAILURE)
+    for(int p_index = 0; p_index < num_pedestrians_to_insert; p_index++)
+    {
+        if( add_new_pedestrian(random_coordinates[p_index]) == FAILURE)
+        {
+            free(random_coordinates);
             return FAILURE;
+        }
 
-        pedestrian_position_grid[line][column] = pedestrian_set.list[pedestrian_set.num_pedestrians - 1]->id;
-
-        p_index++;
+        pedestrian_position_grid[random_coordinates[p_index].lin][random_coordinates[p_index].col] = pedestrian_set.list[pedestrian_set.num_pedestrians - 1]->id;
+        record_heatmap_visit(random_coordinates[p_index]);
     }
 
+    free(random_coordinates);
+
     return SUCCESS;
 }
 
@@ -84,12 +86,16 @@ Function_Status insert_pedestrians_at_random(int num_pedestrians_to_insert)
  * Adds a new pedestrian to the pedestrian set.
  * 
  * @note The ID of the newly created pedestrian is given in this function.
+ * @note The initial cell isn't recorded in the heatmap, which is done by the callers that place the pedestrians of a simulation.
  * 
  * @param ped_coordinates New pedestrian coordinates.
  * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
 Function_Status add_new_pedestrian(Location ped_coordinates)
 {
+    if(reserve_random_streams(pedestrian_set.num_pedestrians + 1) == FAILURE)
+        return FAILURE;
+
     Pedestrian new_pedestrian = create_pedestrian(ped_coordinates);
     if(new_pedestrian == NULL)
     {
@@ -137,49 +143,68 @@ int determine_pedestrians_in_panic()
     int num_pedestrians_in_panic = 0;
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
     {
-        if(pedestrian_set.list[p_index]->state == GOT_OUT)
-            continue;
-
-        if((rand() % 100 + 1) / 100.0 <= PANIC_PROBABILITY)
-        {
-            pedestrian_set.list[p_index]->in_panic = true;
+        if(determine_pedestrian_panic(pedestrian_set.list[p_index]) == true)
             num_pedestrians_in_panic++;
-
-            if(cli_args.show_debug_information)
-                printf("%d in panic.\n", pedestrian_set.list[p_index]->id);
-        }
     }
 
     return num_pedestrians_in_panic;
 }
 
+/**
+ * Determines if the given pedestrian will enter a panic state, with a probability defined by PANIC_PROBABILITY.
+ *
+ * @param current_pedestrian The pedestrian, which may be in any state.
+ * @return bool, where True indicates that the pedestrian entered the panic state.
+*/
+bool determine_pedestrian_panic(Pedestrian current_pedestrian)
+{
+    if(current_pedestrian->state == GOT_OUT)
+        return false;
+
+    if(draw_pedestrian_panic(current_pedestrian) == false)
+        return false;
+
+    current_pedestrian->in_panic = true;
+
+    if(cli_args.show_debug_information)
+        printf("%d in panic.\n", current_pedestrian->id);
+
+    return true;
+}
+
 /**
  * Determines the destination cell for each pedestrian.
 */
 void evaluate_pedestrians_movements()
 {
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
-    {
-        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        evaluate_pedestrian_movement(pedestrian_set.list[p_index]);
+}
 
-        if(current_pedestrian->state != MOVING || current_pedestrian->in_panic == true)
-            continue;
+/**
+ * Determines the destination cell for the given pedestrian, if they are moving and not in panic.
+ *
+ * @param current_pedestrian The pedestrian whose movement will be evaluated.
+*/
+void evaluate_pedestrian_movement(Pedestrian current_pedestrian)
+{
+    if(current_pedestrian->state != MOVING || current_pedestrian->in_panic == true)
+        return;
 
-        Cell destination_cell = find_smallest_cell(current_pedestrian->current, ! cli_args.always_move_to_lowest);
+    Cell destination_cell = find_smallest_cell(current_pedestrian->current, ! cli_args.always_move_to_lowest);
 
-        if(destination_cell.coordinates.lin == -1 && destination_cell.coordinates.col == -1)
-        { 
-            // There isn't a valid cell to move.
-            current_pedestrian->state = STOPPED;
-        
-            if(cli_args.show_debug_information)
-                printf("%d has been cornered.\n", current_pedestrian->id);
-        }
-        else
-        {
-            current_pedestrian->target.lin = destination_cell.coordinates.lin;
-            current_pedestrian->target.col = destination_cell.coordinates.col;
-        }
+    if(destination_cell.coordinates.lin == -1 && destination_cell.coordinates.col == -1)
+    { 
+        // There isn't a valid cell to move.
+        current_pedestrian->state = STOPPED;
+    
+        if(cli_args.show_debug_information)
+            printf("%d has been cornered.\n", current_pedestrian->id);
+    }
+    else
+    {
+        current_pedestrian->target.lin = destination_cell.coordinates.lin;
+        current_pedestrian->target.col = destination_cell.coordinates.col;
     }
 }
 
@@ -281,7 +306,7 @@ Function_Status solve_pedestrian_conflicts(Cell_Conflict pedestrian_conflicts, i
     for(int conflict_index = 0; conflict_index < num_conflicts; conflict_index++)
     {
         Cell_Conflict current_conflict = &(pedestrian_conflicts[conflict_index]);
-        int random_result = rand() % current_conflict->num_pedestrians;
+        int random_result = draw_random_integer(current_conflict->pedestrian_ids[0], CONFLICT_STREAM, current_conflict->num_pedestrians);
 
         current_conflict->pedestrian_allowed = current_conflict->pedestrian_ids[random_result];
         for(int p_index = 0; p_index < current_conflict->num_pedestrians; p_index++)
@@ -382,25 +407,31 @@ void block_X_movement()
 void apply_pedestrian_movement()
 {
     for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+        move_pedestrian(pedestrian_set.list[p_index]);
+}
+
+/**
+ * Moves the given pedestrian to their target location, if they are in the MOVING state, or removes them from the environment, if they are in the LEAVING state.
+ *
+ * @param current_pedestrian The pedestrian to be moved.
+*/
+void move_pedestrian(Pedestrian current_pedestrian)
+{
+    if(current_pedestrian->in_panic == true || current_pedestrian->state == GOT_OUT || current_pedestrian->state == STOPPED)
+        return; // Pedestrian is ignored
+
+    if(current_pedestrian->state == MOVING)
     {
-        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
-        
-        if(current_pedestrian->in_panic == true || current_pedestrian->state == GOT_OUT || current_pedestrian->state == STOPPED)
-            continue; // Pedestrian is ignored
+        current_pedestrian->current = current_pedestrian->target;
 
-        if(current_pedestrian->state == MOVING)
+        if(exits_set.final_floor_field[current_pedestrian->current.lin][current_pedestrian->current.col] == EXIT_VALUE)
         {
-            current_pedestrian->current = current_pedestrian->target;
-
-            if(exits_set.final_floor_field[current_pedestrian->current.lin][current_pedestrian->current.col] == EXIT_VALUE)
-            {
-                current_pedestrian->state = cli_args.immediate_exit ? GOT_OUT : LEAVING; 
-                // Leaving means the pedestrian will remain for a timestep before being removed from the environment.
-            }
+            current_pedestrian->state = cli_args.immediate_exit ? GOT_OUT : LEAVING; 
+            // Leaving means the pedestrian will remain for a timestep before being removed from the environment.
         }
-        else if(current_pedestrian->state == LEAVING)
-            current_pedestrian->state = GOT_OUT; // After a timestep in the exit the pedestrian is removed from the environment.
     }
+    else if(current_pedestrian->state == LEAVING)
+        current_pedestrian->state = GOT_OUT; // After a timestep in the exit the pedestrian is removed from the environment.
 }
 
 /**
@@ -434,7 +465,7 @@ void update_pedestrian_position_grid()
             continue;
 
         pedestrian_position_grid[current_pedestrian->current.lin][current_pedestrian->current.col] = current_pedestrian->id;
-        heatmap_grid[current_pedestrian->current.lin][current_pedestrian->current.col]++;
+        record_heatmap_visit(current_pedestrian->current);
     }
 }
 
@@ -477,36 +508,37 @@ void reset_pedestrians_structures()
         current_pedestrian->current.col = current_pedestrian->origin.col;
         current_pedestrian->state = MOVING;
         current_pedestrian->in_panic = false;
+        current_pedestrian->timesteps_to_panic = 0;
+        current_pedestrian->best_floor_field_value = DBL_MAX;
         pedestrian_position_grid[current_pedestrian->current.lin][current_pedestrian->current.col] = current_pedestrian->id;
     }
 }
 
-/* ---------------- ---------------- ---------------- ---------------- ---------------- */
-/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
-/* ---------------- ---------------- ---------------- ---------------- ---------------- */
-
 /**
- * Creates a new Pedestrian structure based on the given Location.
- * 
- * @note The Pedestrian id is not filled.
- * 
- * @param ped_coordinates New pedestrian coordinates.
- * @return A Null pointer, on error, or a Pedestrian structure if the new Pedestrian is successfully created.
-*/ 
-static Pedestrian create_pedestrian(Location ped_coordinates)
+ * Runs a timestep of the current simulation: the pedestrians evaluate their movements, the conflicts between them are solved and they are moved to their targets.
+ *
+ * @note The floor fields must be already calculated for the current positions of the pedestrians.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status run_pedestrian_timestep()
 {
-    Pedestrian new_pedestrian = malloc(sizeof(struct pedestrian));
-    if(new_pedestrian != NULL)
-    {
-        new_pedestrian->current = new_pedestrian->origin = ped_coordinates;
-        new_pedestrian->target = (Location) {-1, -1};
-        new_pedestrian->state = MOVING;
-        new_pedestrian->in_panic = false;
+    evaluate_pedestrians_movements();
+    determine_pedestrians_in_panic();
 
-        heatmap_grid[ped_coordinates.lin][ped_coordinates.col]++;
-    }
+    if(!cli_args.allow_X_movement)
+        block_X_movement(); // Runs when allow_X_movement is false.
 
-    return new_pedestrian;
+    if(conflict_solving() == FAILURE)
+        return FAILURE;
+
+    apply_pedestrian_movement();
+
+    update_pedestrian_position_grid();
+    reset_pedestrian_state();
+    reset_pedestrian_panic();
+
+    return SUCCESS;
 }
 
 /**
@@ -516,7 +548,7 @@ static Pedestrian create_pedestrian(Location ped_coordinates)
  * @param second_pedestrian A Pedestrian adjacent to the first_pedestrian.
  * @return bool, where True indicates that the paths cross and False otherwise.
 */
-static bool are_pedestrian_paths_crossing(Pedestrian first_pedestrian, Pedestrian second_pedestrian)
+bool are_pedestrian_paths_crossing(Pedestrian first_pedestrian, Pedestrian second_pedestrian)
 {
     if(first_pedestrian->state != MOVING || second_pedestrian->state != MOVING || 
         first_pedestrian->in_panic == true || second_pedestrian->in_panic == true)
@@ -551,6 +583,55 @@ static bool are_pedestrian_paths_crossing(Pedestrian first_pedestrian, Pedestria
     return false;
 }
 
+/**
+ * Decides which of the given pedestrians will be allowed to move.
+ * 
+ * @param first_pedestrian A Pedestrian involved in a X movement.
+ * @param second_pedestrian A pedestrian involved in an X movement.
+*/
+void solve_X_movement(Pedestrian first_pedestrian, Pedestrian second_pedestrian)
+{
+    int sorted_num = draw_random_integer(first_pedestrian->id, X_MOVEMENT_STREAM, 100);
+
+    if(sorted_num < 50)
+        second_pedestrian->state = STOPPED;
+    else
+        first_pedestrian->state = STOPPED;
+
+    if(cli_args.show_debug_information)
+        printf("X Movement between %d and %d --> %d.\n", first_pedestrian->id, second_pedestrian->id, 
+                                                         sorted_num < 50 ? first_pedestrian->id : second_pedestrian->id);
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Creates a new Pedestrian structure based on the given Location.
+ * 
+ * @note The Pedestrian id is not filled.
+ * 
+ * @param ped_coordinates New pedestrian coordinates.
+ * @return A Null pointer, on error, or a Pedestrian structure if the new Pedestrian is successfully created.
+*/ 
+static Pedestrian create_pedestrian(Location ped_coordinates)
+{
+    Pedestrian new_pedestrian = malloc(sizeof(struct pedestrian));
+    if(new_pedestrian != NULL)
+    {
+        new_pedestrian->current = new_pedestrian->origin = ped_coordinates;
+        new_pedestrian->target = (Location) {-1, -1};
+        new_pedestrian->state = MOVING;
+        new_pedestrian->in_panic = false;
+        new_pedestrian->timesteps_to_panic = 0;
+        new_pedestrian->best_floor_field_value = DBL_MAX;
+    }
+
+    return new_pedestrian;
+}
+
+
 /**
  * Calculate the reduced line equation (slope-intercept form) for the line segment beginning at origin and ending at target.
  * 
@@ -625,21 +706,24 @@ static bool is_intersection_within_pedestrian_movement(double x_coordinate, doub
 }
 
 /**
- * Decides which of the given pedestrians will be allowed to move.
- * 
- * @param first_pedestrian A Pedestrian involved in a X movement.
- * @param second_pedestrian A pedestrian involved in an X movement.
+ * Calls the necessary functions to identify and solve conflicts between pedestrians.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
 */
-static void solve_X_movement(Pedestrian first_pedestrian, Pedestrian second_pedestrian)
+static Function_Status conflict_solving()
 {
-    int sorted_num = rand() % 100;
+    Cell_Conflict pedestrian_conflicts = NULL;
+    int num_conflicts = 0;
 
-    if(sorted_num < 50)
-        second_pedestrian->state = STOPPED;
-    else
-        first_pedestrian->state = STOPPED;
+    if(identify_pedestrian_conflicts(&pedestrian_conflicts, &num_conflicts) == FAILURE)
+        return FAILURE;                
+
+    if(solve_pedestrian_conflicts(pedestrian_conflicts, num_conflicts) == FAILURE)
+        return FAILURE;
 
     if(cli_args.show_debug_information)
-        printf("X Movement between %d and %d --> %d.\n", first_pedestrian->id, second_pedestrian->id, 
-                                                         sorted_num < 50 ? first_pedestrian->id : second_pedestrian->id);
-}
\ No newline at end of file
+        print_pedestrian_conflict_information(pedestrian_conflicts, num_conflicts);
+
+    free(pedestrian_conflicts);
+
+    return SUCCESS;
+}
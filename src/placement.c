@@ -0,0 +1,232 @@
+/*
+   File: placement.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module draws the cells of the pedestrians placed at random. The free cells of the environment (inside the spawn zones of the --spawn-zones option, if given), which are neither walls nor exits, are listed once for each simulation set, and the cells of a simulation are drawn by a partial Fisher-Yates shuffle of that list, so each pedestrian takes a single draw among the cells not taken yet, whatever the density of the crowd. A request for more pedestrians than free cells is reported as an error.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+
+#include"../headers/exit.h"
+#include"../headers/grid.h"
+#include"../headers/placement.h"
+#include"../headers/random_stream.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    Location first; // Upper left cell.
+    Location last; // Lower right cell.
+} Spawn_Zone;
+
+static int *placement_cells = NULL; // Free cells of the environment inside the spawn zones, as line * columns + column, for the exits of the current simulation set.
+static int num_placement_cells = 0;
+
+static Function_Status build_placement_cells();
+static Function_Status parse_spawn_zones(Spawn_Zone *zones, int *num_zones);
+static bool is_within_spawn_zones(Spawn_Zone *zones, int num_zones, int line, int column);
+
+/**
+ * Draws distinct free cells for the pedestrians of a simulation, the cell of the pedestrian k (from 0) being drawn from the placement substream of the pedestrian id k + 1.
+ *
+ * @note The list of free cells is built on the first call of each simulation set, so the environment and the exits of the set must be loaded.
+ *
+ * @param num_cells Number of cells to be drawn.
+ * @param drawn_cells Array where the num_cells drawn cells will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status draw_placement_cells(int num_cells, Location *drawn_cells)
+{
+    if(placement_cells == NULL && build_placement_cells() == FAILURE)
+        return FAILURE;
+
+    if(num_cells > num_placement_cells)
+    {
+        fprintf(stderr, "There are only %d free cells%s for the %d pedestrians to be randomly placed.\n",
+                num_placement_cells, cli_args.spawn_zones[0] != '\0' ? " in the spawn zones" : " in the environment", num_cells);
+        return FAILURE;
+    }
+
+    int *drawn_indexes = malloc(sizeof(int) * num_cells);
+    if(drawn_indexes == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the indexes of the placement cells.\n");
+        return FAILURE;
+    }
+
+    // The cells not drawn yet are kept after the position k of the list.
+    for(int k = 0; k < num_cells; k++)
+    {
+        drawn_indexes[k] = k + draw_random_integer(k + 1, PLACEMENT_STREAM, num_placement_cells - k);
+
+        int drawn_cell = placement_cells[drawn_indexes[k]];
+        placement_cells[drawn_indexes[k]] = placement_cells[k];
+        placement_cells[k] = drawn_cell;
+
+        drawn_cells[k] = (Location) {drawn_cell / cli_args.global_column_number, drawn_cell % cli_args.global_column_number};
+    }
+
+    // The swaps are undone, so the draws of every simulation start from the same list.
+    for(int k = num_cells - 1; k >= 0; k--)
+    {
+        int drawn_cell = placement_cells[k];
+        placement_cells[k] = placement_cells[drawn_indexes[k]];
+        placement_cells[drawn_indexes[k]] = drawn_cell;
+    }
+
+    free(drawn_indexes);
+
+    return SUCCESS;
+}
+
+/**
+ * Deallocates the list of free cells, which must be done whenever the exits change, so the list is built again for the new exits.
+*/
+void deallocate_placement_cells()
+{
+    free(placement_cells);
+    placement_cells = NULL;
+    num_placement_cells = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Lists the cells of the environment that aren't walls nor exits and are inside the spawn zones, in row-major order.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status build_placement_cells()
+{
+    Spawn_Zone zones[MAX_SPAWN_ZONES];
+    int num_zones = 0;
+
+    if(parse_spawn_zones(zones, &num_zones) == FAILURE)
+        return FAILURE;
+
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    // The exits given by the auxiliary file or the --exit-sets option aren't walls of environment_only_grid, so their cells are marked apart.
+    bool *is_exit_cell = calloc((size_t) lines * columns, sizeof(bool));
+    if(is_exit_cell == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the exit cells at build_placement_cells.\n");
+        return FAILURE;
+    }
+
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+        for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+            is_exit_cell[current_exit->coordinates[cell_index].lin * columns + current_exit->coordinates[cell_index].col] = true;
+    }
+
+    int num_free_cells = 0;
+    for(int i = 0; i < lines; i++)
+    {
+        for(int h = 0; h < columns; h++)
+        {
+            if(environment_only_grid[i][h] != WALL_VALUE && ! is_exit_cell[i * columns + h] && is_within_spawn_zones(zones, num_zones, i, h))
+                num_free_cells++;
+        }
+    }
+
+    placement_cells = malloc(sizeof(int) * (num_free_cells > 0 ? num_free_cells : 1));
+    if(placement_cells == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the list of placement cells.\n");
+        free(is_exit_cell);
+        return FAILURE;
+    }
+
+    num_placement_cells = 0;
+    for(int i = 0; i < lines; i++)
+    {
+        for(int h = 0; h < columns; h++)
+        {
+            if(environment_only_grid[i][h] != WALL_VALUE && ! is_exit_cell[i * columns + h] && is_within_spawn_zones(zones, num_zones, i, h))
+                placement_cells[num_placement_cells++] = i * columns + h;
+        }
+    }
+
+    free(is_exit_cell);
+
+    return SUCCESS;
+}
+
+/**
+ * Reads the spawn zones of the --spawn-zones option: rectangles separated by commas, each given by the line and column of two opposite corners.
+ *
+ * @param zones Array where the spawn zones will be stored.
+ * @param num_zones Where the number of spawn zones will be stored (0 if the option wasn't given).
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status parse_spawn_zones(Spawn_Zone *zones, int *num_zones)
+{
+    *num_zones = 0;
+
+    const char *position = cli_args.spawn_zones;
+    while(*position != '\0')
+    {
+        if(*num_zones == MAX_SPAWN_ZONES)
+        {
+            fprintf(stderr, "At most %d spawn zones can be given.\n", MAX_SPAWN_ZONES);
+            return FAILURE;
+        }
+
+        int corners[4], num_characters = 0;
+        if(sscanf(position, " %d %d %d %d %n", &corners[0], &corners[1], &corners[2], &corners[3], &num_characters) != 4 ||
+           (position[num_characters] != ',' && position[num_characters] != '\0'))
+        {
+            fprintf(stderr, "Invalid spawn zone: %s. Each spawn zone must be given as LINE COLUMN LINE COLUMN.\n", position);
+            return FAILURE;
+        }
+
+        for(int corner = 0; corner < 2; corner++)
+        {
+            if(! is_within_grid_lines(corners[2 * corner]) || ! is_within_grid_columns(corners[2 * corner + 1]))
+            {
+                fprintf(stderr, "The spawn zone corner (%d,%d) is outside the environment.\n", corners[2 * corner], corners[2 * corner + 1]);
+                return FAILURE;
+            }
+        }
+
+        zones[*num_zones].first = (Location) {corners[0] < corners[2] ? corners[0] : corners[2], corners[1] < corners[3] ? corners[1] : corners[3]};
+        zones[*num_zones].last = (Location) {corners[0] < corners[2] ? corners[2] : corners[0], corners[1] < corners[3] ? corners[3] : corners[1]};
+        (*num_zones)++;
+
+        position += num_characters;
+        if(*position == ',')
+            position++;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Verifies if the given cell is inside one of the spawn zones.
+ *
+ * @param zones Spawn zones.
+ * @param num_zones Number of spawn zones; without spawn zones, every cell is accepted.
+ * @param line Line of the cell.
+ * @param column Column of the cell.
+ * @return bool, where True indicates that the cell is inside a spawn zone.
+*/
+static bool is_within_spawn_zones(Spawn_Zone *zones, int num_zones, int line, int column)
+{
+    if(num_zones == 0)
+        return true;
+
+    for(int zone_index = 0; zone_index < num_zones; zone_index++)
+    {
+        if(line >= zones[zone_index].first.lin && line <= zones[zone_index].last.lin &&
+           column >= zones[zone_index].first.col && column <= zones[zone_index].last.col)
+            return true;
+    }
+
+    return false;
+}
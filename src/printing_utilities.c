@@ -8,9 +8,11 @@
 #include<stdio.h>
 #include<string.h>
 #include<time.h>
+#include<math.h>
 
 #include"../headers/exit.h"
 #include"../headers/pedestrian.h"
+#include"../headers/output_writer.h"
 #include"../headers/cli_processing.h"
 #include"../headers/printing_utilities.h"
 #include"../headers/shared_resources.h"
@@ -44,16 +46,151 @@ void print_heatmap(FILE *output_stream)
 	{
 		for(int i = 0; i < cli_args.global_line_number; i++){
 			for(int h = 0; h < cli_args.global_column_number; h++)
-				fprintf(output_stream, "%.2lf ", (double) heatmap_grid[i][h] / (double) cli_args.num_simulations);
+				write_fixed(output_stream, (double) heatmap_grid[i][h] / (double) cli_args.num_simulations, 2, ' ');
 
-			fprintf(output_stream,"\n");
+			write_text(output_stream, "\n");
 		}
-		fprintf(output_stream,"\n");
+		write_text(output_stream, "\n");
 	}
 	else
 		fprintf(stderr, "No valid stream was provided at print_heatmap.\n");
 }
 
+/**
+ * Print the heatmap grid on the provided stream, using the sparse encoding: a line with the number of lines, columns and runs, followed by one line per run of cells with visits in the same line (line, first column, length and the value of each cell).
+ * 
+ * @note As in print_heatmap, the value of each cell is the mean of all simulations.
+ * 
+ * @param output_stream Stream where the data will be written.
+*/
+void print_sparse_heatmap(FILE *output_stream)
+{
+	if(output_stream == NULL)
+	{
+		fprintf(stderr, "No valid stream was provided at print_sparse_heatmap.\n");
+		return;
+	}
+
+	int num_runs = 0;
+	for(int i = 0; i < cli_args.global_line_number; i++){
+		for(int h = 0; h < cli_args.global_column_number; h++)
+		{
+			if(heatmap_grid[i][h] != 0 && (h == 0 || heatmap_grid[i][h - 1] == 0))
+				num_runs++;
+		}
+	}
+
+	fprintf(output_stream, "%d %d %d\n", cli_args.global_line_number, cli_args.global_column_number, num_runs);
+
+	for(int i = 0; i < cli_args.global_line_number; i++){
+		int h = 0;
+		while(h < cli_args.global_column_number)
+		{
+			if(heatmap_grid[i][h] == 0)
+			{
+				h++;
+				continue;
+			}
+
+			int run_length = 0;
+			while(h + run_length < cli_args.global_column_number && heatmap_grid[i][h + run_length] != 0)
+				run_length++;
+
+			write_integer(output_stream, i, ' ');
+			write_integer(output_stream, h, ' ');
+			write_integer(output_stream, run_length, ' ');
+			for(; run_length > 0; run_length--, h++)
+				write_fixed(output_stream, (double) heatmap_grid[i][h] / (double) cli_args.num_simulations, 2, ' ');
+
+			write_text(output_stream, "\n");
+		}
+	}
+	fprintf(output_stream, "\n");
+}
+
+/**
+ * Print a summary of the evacuation times of a simulation set on the provided stream: number of simulations, mean, sample variance, minimum, maximum and the 5th, 25th, 50th, 75th and 95th percentiles.
+ * 
+ * @note An empty accumulator (e.g. a simulation set with inaccessible exits) is printed with -1 in every column except the first.
+ * 
+ * @param output_stream Stream where the data will be written.
+ * @param statistics Accumulator holding the evacuation times of the simulation set.
+*/
+void print_evacuation_statistics(FILE *output_stream, Streaming_Statistics *statistics)
+{
+	double quantiles[] = {0.05, 0.25, 0.50, 0.75, 0.95};
+
+	if(output_stream != NULL)
+	{
+		if(statistics->count == 0)
+		{
+			fprintf(output_stream, "0 -1 -1 -1 -1 -1 -1 -1 -1 -1 ");
+			return;
+		}
+
+		fprintf(output_stream, "%d %.3lf %.3lf %d %d ", statistics->count, statistics->mean, 
+				calculate_streaming_variance(statistics), statistics->minimum, statistics->maximum);
+
+		for(int q_index = 0; q_index < 5; q_index++)
+			fprintf(output_stream, "%.1lf ", calculate_streaming_quantile(statistics, quantiles[q_index]));
+	}
+	else
+		fprintf(stderr, "No valid stream was provided at print_evacuation_statistics.\n");
+}
+
+/**
+ * Print the difference in the evacuation times between a simulation set and the reference simulation set, paired by seed, on the provided stream: number of pairs, mean difference, sample standard deviation of the differences and half-width of the 95% confidence interval of the mean difference.
+ * 
+ * @note When no pair is provided (e.g. a simulation set with inaccessible exits), -1 is printed in every column except the first.
+ * @note Pairs where either evacuation time is negative (a censored simulation) are left out, and aren't counted in the first column.
+ * 
+ * @param output_stream Stream where the data will be written.
+ * @param reference_timesteps Evacuation times of the reference simulation set, indexed by simulation.
+ * @param current_timesteps Evacuation times of the current simulation set, indexed by simulation.
+ * @param num_pairs Number of simulations in both lists.
+*/
+void print_paired_difference(FILE *output_stream, int *reference_timesteps, int *current_timesteps, int num_pairs)
+{
+	if(output_stream != NULL)
+	{
+		int num_valid_pairs = 0;
+		double mean = 0.0;
+		for(int pair_index = 0; pair_index < num_pairs; pair_index++)
+		{
+			if(reference_timesteps[pair_index] < 0 || current_timesteps[pair_index] < 0)
+				continue;
+
+			mean += current_timesteps[pair_index] - reference_timesteps[pair_index];
+			num_valid_pairs++;
+		}
+
+		if(num_valid_pairs == 0)
+		{
+			fprintf(output_stream, "0 -1 -1 -1 ");
+			return;
+		}
+
+		mean /= num_valid_pairs;
+
+		double sum_squared_deviations = 0.0;
+		for(int pair_index = 0; pair_index < num_pairs; pair_index++)
+		{
+			if(reference_timesteps[pair_index] < 0 || current_timesteps[pair_index] < 0)
+				continue;
+
+			double deviation = current_timesteps[pair_index] - reference_timesteps[pair_index] - mean;
+			sum_squared_deviations += deviation * deviation;
+		}
+
+		double variance = num_valid_pairs > 1 ? sum_squared_deviations / (num_valid_pairs - 1) : 0.0;
+		double half_width = num_valid_pairs > 1 ? calculate_confidence_half_width(num_valid_pairs, variance) : 0.0;
+
+		fprintf(output_stream, "%d %.3lf %.3lf %.3lf ", num_valid_pairs, mean, sqrt(variance), half_width);
+	}
+	else
+		fprintf(stderr, "No valid stream was provided at print_paired_difference.\n");
+}
+
 /**
  * Print the pedestrian position grid (with emojis instead of values) on the provided stream.
  * 
@@ -74,17 +211,17 @@ void print_pedestrian_position_grid(FILE *output_stream, int simulation_number,
 			for(int h = 0; h < cli_args.global_column_number; h++)
 			{
 				if(pedestrian_position_grid[i][h] != 0)
-					fprintf(output_stream,"👤");
+					write_text(output_stream,"👤");
 				else if(exits_set.final_floor_field[i][h] == EXIT_VALUE)
-					fprintf(output_stream,"🚪");
+					write_text(output_stream,"🚪");
 				else if(exits_set.final_floor_field[i][h] == WALL_VALUE)
-					fprintf(output_stream,"🧱");
+					write_text(output_stream,"🧱");
 				else if(pedestrian_position_grid[i][h] == 0)
-					fprintf(output_stream,"⬛");
+					write_text(output_stream,"⬛");
 			}
-			fprintf(output_stream,"\n");
+			write_text(output_stream,"\n");
 		}
-		fprintf(output_stream,"\n");
+		write_text(output_stream,"\n");
 	}
 	else
 		fprintf(stderr, "No valid stream was provided at print_pedestrian_position_grid.\n");		
@@ -195,7 +332,7 @@ void print_placeholder(FILE *stream, int placeholder)
 {
 	for(int times = 0; times < cli_args.num_simulations; times++)
 	{
-		fprintf(stream, "%d ", placeholder);
+		write_integer(stream, placeholder, ' ');
 	}
-	fprintf(stream, "\n");
+	write_text(stream, "\n");
 }
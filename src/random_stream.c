@@ -0,0 +1,198 @@
+/*
+   File: random_stream.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module centralizes the random draws of the simulation. By default, every draw comes from the global rand() stream. When the common random numbers mode is enabled, each pedestrian has an independent substream for each type of decision, keyed by the seed, the pedestrian id and the decision type, so that different simulation sets consume the same random numbers for the same pedestrians.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<string.h>
+#include<math.h>
+#include<limits.h>
+
+#include"../headers/random_stream.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static uint64_t stream_seed = 0;
+static unsigned int *stream_counters = NULL; // Number of draws already made by each (pedestrian, stream) pair.
+static int stream_counters_capacity = 0; // Number of pedestrians covered by stream_counters.
+
+static Function_Status ensure_stream_counters_capacity(int pedestrian_id);
+static uint64_t draw_substream_bits(int pedestrian_id, enum Random_Stream stream);
+static uint64_t mix_bits(uint64_t value);
+
+/**
+ * Restarts all substreams for a new simulation with the given seed.
+ *
+ * @note Has no effect on the global rand() stream, which must still be seeded with srand.
+ *
+ * @param seed Seed of the simulation.
+*/
+void reset_random_streams(int seed)
+{
+    stream_seed = mix_bits((uint64_t) seed);
+
+    if(stream_counters != NULL)
+        memset(stream_counters, 0, sizeof(unsigned int) * stream_counters_capacity * NUM_RANDOM_STREAMS);
+}
+
+/**
+ * Draws a random integer in the interval [0, upper_bound) for the given pedestrian and decision type.
+ *
+ * @note Without the common random numbers mode, the draw is rand() % upper_bound, regardless of the pedestrian and the stream. Otherwise, the substreams of the pedestrian must have been reserved (see reserve_random_streams).
+ *
+ * @param pedestrian_id Id of the pedestrian that owns the substream (starting at 1).
+ * @param stream Type of decision for which the number is drawn.
+ * @param upper_bound Exclusive upper limit of the drawn integer.
+ * @return An integer between 0 and upper_bound - 1.
+*/
+int draw_random_integer(int pedestrian_id, enum Random_Stream stream, int upper_bound)
+{
+    if(! cli_args.common_random_numbers)
+        return rand() % upper_bound;
+
+    uint64_t drawn_bits = draw_substream_bits(pedestrian_id, stream);
+
+    return (int) (((drawn_bits >> 32) * (uint64_t) upper_bound) >> 32);
+}
+
+/**
+ * Draws the number of Bernoulli trials with the given success probability up to (and including) the first success, for the given pedestrian and decision type, with a single draw: the gap is 1 + floor(log(U) / log(1 - probability)), for U uniform in (0, 1].
+ *
+ * @note Without the common random numbers mode, U comes from the rand() stream. Otherwise, the substreams of the pedestrian must have been reserved (see reserve_random_streams).
+ *
+ * @param pedestrian_id Id of the pedestrian that owns the substream (starting at 1).
+ * @param stream Type of decision for which the number is drawn.
+ * @param probability Success probability of each trial, greater than 0.
+ * @return An integer greater than or equal to 1.
+*/
+int draw_random_geometric(int pedestrian_id, enum Random_Stream stream, double probability)
+{
+    if(probability >= 1.0)
+        return 1;
+
+    double uniform;
+    if(! cli_args.common_random_numbers)
+        uniform = (rand() + 1.0) / ((double) RAND_MAX + 1.0);
+    else
+        uniform = ((draw_substream_bits(pedestrian_id, stream) >> 11) + 1) * 0x1.0p-53; // The 53 upper bits, as a double in (0, 1].
+
+    double gap = floor(log(uniform) / log1p(-probability)) + 1;
+
+    return gap < INT_MAX ? (int) gap : INT_MAX;
+}
+
+/**
+ * Guarantees that the substreams of the pedestrians with ids up to max_pedestrian_id exist, so that the draws never allocate memory and pedestrians can draw from their own substreams concurrently. Called whenever pedestrians are created, so an allocation failure stops the simulation instead of breaking the pairing of the common random numbers.
+ *
+ * @note Has no effect without the common random numbers mode.
+ *
+ * @param max_pedestrian_id Highest pedestrian id.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status reserve_random_streams(int max_pedestrian_id)
+{
+    if(! cli_args.common_random_numbers)
+        return SUCCESS;
+
+    return ensure_stream_counters_capacity(max_pedestrian_id);
+}
+
+/**
+ * Exchanges the substreams in use with the ones kept in the given state, so that several simulations can take turns drawing from their own substreams. Calling it again with the same state restores the previous substreams.
+ *
+ * @param state Substreams of another simulation. A zeroed state holds no counters, which are allocated by reserve_random_streams before the first draw.
+*/
+void swap_random_stream_state(Random_Stream_State *state)
+{
+    Random_Stream_State previous_state = {stream_seed, stream_counters, stream_counters_capacity};
+
+    stream_seed = state->seed;
+    stream_counters = state->counters;
+    stream_counters_capacity = state->capacity;
+
+    *state = previous_state;
+}
+
+/**
+ * Deallocates the counters of the substreams.
+*/
+void deallocate_random_streams()
+{
+    free(stream_counters);
+    stream_counters = NULL;
+    stream_counters_capacity = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Guarantees that stream_counters has room for the substreams of the given pedestrian, growing it if necessary.
+ *
+ * @param pedestrian_id Id of the pedestrian.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status ensure_stream_counters_capacity(int pedestrian_id)
+{
+    if(pedestrian_id < stream_counters_capacity)
+        return SUCCESS;
+
+    int new_capacity = stream_counters_capacity == 0 ? 64 : stream_counters_capacity;
+    while(new_capacity <= pedestrian_id)
+        new_capacity *= 2;
+
+    unsigned int *new_counters = realloc(stream_counters, sizeof(unsigned int) * new_capacity * NUM_RANDOM_STREAMS);
+    if(new_counters == NULL)
+    {
+        fprintf(stderr, "Failure in the realloc of the random stream counters.\n");
+        return FAILURE;
+    }
+
+    memset(new_counters + stream_counters_capacity * NUM_RANDOM_STREAMS, 0,
+           sizeof(unsigned int) * (new_capacity - stream_counters_capacity) * NUM_RANDOM_STREAMS);
+
+    stream_counters = new_counters;
+    stream_counters_capacity = new_capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * Draws the next 64 bits of the substream of the given pedestrian and decision type.
+ *
+ * @note The counters of the pedestrian must exist (see reserve_random_streams).
+ *
+ * @param pedestrian_id Id of the pedestrian that owns the substream.
+ * @param stream Type of decision for which the bits are drawn.
+ * @return The drawn bits.
+*/
+static uint64_t draw_substream_bits(int pedestrian_id, enum Random_Stream stream)
+{
+    unsigned int *counter = &stream_counters[pedestrian_id * NUM_RANDOM_STREAMS + stream];
+
+    uint64_t drawn_bits = mix_bits(stream_seed ^ (uint64_t) pedestrian_id);
+    drawn_bits = mix_bits(drawn_bits ^ (uint64_t) stream);
+    drawn_bits = mix_bits(drawn_bits ^ (uint64_t) *counter);
+    (*counter)++;
+
+    return drawn_bits;
+}
+
+/**
+ * Scrambles the bits of the given value with the finalizer of the SplitMix64 generator.
+ *
+ * @param value Value to be scrambled.
+ * @return The scrambled value.
+*/
+static uint64_t mix_bits(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
@@ -0,0 +1,592 @@
+/*
+   File: set_generator.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module expands the generator expressions of the auxiliary syntax, which describe many simulation sets at once (e.g. every pair of doors along the border). The valid doors are listed once, when the generator is created; the combinations are then enumerated lazily, so any simulation set can be loaded by its index without storing the others. Inaccessible doors and overlapping doors are skipped up front and, optionally, so are combinations that mirror a previous one.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+
+#include"../headers/exit.h"
+#include"../headers/grid.h"
+#include"../headers/set_generator.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+enum Symmetry{
+    MIRRORED_COLUMNS,
+    MIRRORED_LINES,
+    MIRRORED_BOTH
+};
+
+static Function_Status parse_generator_expression(Set_Generator generator, char *expression);
+static bool parse_range(const char *text, int *minimum, int *maximum);
+static Function_Status list_door_placements(Set_Generator generator);
+static Function_Status find_mirrored_placements(Set_Generator generator);
+static int get_side_length(enum Border_Side side);
+static Location get_placement_cell(Door_Placement placement, int cell_index);
+static bool is_placement_accessible(Door_Placement placement);
+static bool is_environment_symmetric(enum Symmetry symmetry);
+static Door_Placement mirror_placement(Door_Placement placement, enum Symmetry symmetry);
+static bool advance_combination(Set_Generator generator);
+static bool advance_set(Set_Generator generator);
+static bool is_combination_valid(Set_Generator generator);
+static int compare_indices(const void *first, const void *second);
+
+/**
+ * Creates a generator from a generator expression, listing the valid doors and counting the generated simulation sets.
+ *
+ * @note The environment must be loaded beforehand, as the validity of the doors depends on it.
+ *
+ * @param expression Text of the expression, without the leading @ and the final period.
+ * @param length Number of characters of the expression.
+ * @return A NULL pointer, on error, or the generator.
+*/
+Set_Generator create_set_generator(const char *expression, size_t length)
+{
+    char expression_copy[200];
+
+    if(length >= sizeof(expression_copy))
+    {
+        fprintf(stderr, "The generator expression is too long.\n");
+        return NULL;
+    }
+
+    memcpy(expression_copy, expression, length);
+    expression_copy[length] = '\0';
+
+    Set_Generator generator = calloc(1, sizeof(struct set_generator));
+    if(generator == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of a simulation set generator.\n");
+        return NULL;
+    }
+
+    if(parse_generator_expression(generator, expression_copy) == FAILURE || list_door_placements(generator) == FAILURE)
+    {
+        deallocate_set_generator(generator);
+        return NULL;
+    }
+
+    if(generator->unique && find_mirrored_placements(generator) == FAILURE)
+    {
+        deallocate_set_generator(generator);
+        return NULL;
+    }
+
+    generator->combination = malloc(sizeof(int) * generator->max_doors);
+    if(generator->combination == NULL)
+    {
+        fprintf(stderr, "Failure in the allocation of a simulation set generator.\n");
+        deallocate_set_generator(generator);
+        return NULL;
+    }
+
+    generator->current_set = -1;
+    generator->current_doors = 0;
+    while(advance_set(generator))
+    {
+        if(generator->num_sets == INT_MAX)
+        {
+            fprintf(stderr, "The generator expression produces too many simulation sets.\n");
+            deallocate_set_generator(generator);
+            return NULL;
+        }
+
+        generator->num_sets++;
+    }
+
+    generator->current_set = -1;
+    generator->current_doors = 0;
+
+    return generator;
+}
+
+/**
+ * Returns the number of simulation sets produced by the generator.
+ *
+ * @param generator Generator of simulation sets.
+ * @return A non-negative integer.
+*/
+int get_generated_set_quantity(Set_Generator generator)
+{
+    return generator->num_sets;
+}
+
+/**
+ * Adds the exits of the simulation set with the given index, among the sets produced by the generator, to the environment.
+ *
+ * @note Loading the sets in increasing order costs a single step of the enumeration per set.
+ *
+ * @param generator Generator of simulation sets.
+ * @param set_index Index of the simulation set (starting at 0) among the sets produced by the generator.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status load_generated_set(Set_Generator generator, int set_index)
+{
+    if(set_index < 0 || set_index >= generator->num_sets)
+        return FAILURE;
+
+    if(set_index <= generator->current_set) // Restarts the enumeration.
+    {
+        generator->current_set = -1;
+        generator->current_doors = 0;
+    }
+
+    while(generator->current_set < set_index)
+    {
+        if(advance_set(generator) == false)
+            return FAILURE;
+    }
+
+    for(int door_index = 0; door_index < generator->current_doors; door_index++)
+    {
+        Door_Placement placement = generator->placements[generator->combination[door_index]];
+
+        if(add_new_exit(get_placement_cell(placement, 0)) == FAILURE)
+            return FAILURE;
+
+        for(int cell_index = 1; cell_index < placement.width; cell_index++)
+        {
+            if(expand_exit(exits_set.list[exits_set.num_exits - 1], get_placement_cell(placement, cell_index)) == FAILURE)
+                return FAILURE;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Deallocates a generator of simulation sets.
+ *
+ * @param generator Generator to be deallocated.
+*/
+void deallocate_set_generator(Set_Generator generator)
+{
+    if(generator == NULL)
+        return;
+
+    for(int symmetry = 0; symmetry < GENERATOR_SYMMETRIES; symmetry++)
+        free(generator->mirrors[symmetry]);
+
+    free(generator->placements);
+    free(generator->combination);
+    free(generator);
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Extracts the parameters of the generator from its expression.
+ *
+ * @param generator Generator where the parameters will be stored.
+ * @param expression Text of the expression, which is modified by the tokenization.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status parse_generator_expression(Set_Generator generator, char *expression)
+{
+    const char *delimiters = " \t\r\n";
+    char *name = strtok(expression, delimiters);
+    char *doors = strtok(NULL, delimiters);
+    char *width = strtok(NULL, delimiters);
+
+    if(name == NULL || strcmp(name, "doors") != 0)
+    {
+        fprintf(stderr, "Unknown generator in the auxiliary syntax. The available generator is @doors COUNT[-COUNT] WIDTH[-WIDTH] [SIDE] [unique].\n");
+        return FAILURE;
+    }
+
+    if(doors == NULL || width == NULL || parse_range(doors, &generator->min_doors, &generator->max_doors) == false ||
+       parse_range(width, &generator->min_width, &generator->max_width) == false)
+    {
+        fprintf(stderr, "The @doors generator requires a positive number (or range) of doors and of cells per door.\n");
+        return FAILURE;
+    }
+
+    generator->side = WHOLE_BORDER;
+    generator->unique = false;
+
+    char *token;
+    while((token = strtok(NULL, delimiters)) != NULL)
+    {
+        if(strcmp(token, "border") == 0)
+            generator->side = WHOLE_BORDER;
+        else if(strcmp(token, "top") == 0)
+            generator->side = TOP_SIDE;
+        else if(strcmp(token, "bottom") == 0)
+            generator->side = BOTTOM_SIDE;
+        else if(strcmp(token, "left") == 0)
+            generator->side = LEFT_SIDE;
+        else if(strcmp(token, "right") == 0)
+            generator->side = RIGHT_SIDE;
+        else if(strcmp(token, "unique") == 0)
+            generator->unique = true;
+        else
+        {
+            fprintf(stderr, "Unknown parameter of the @doors generator: %s.\n", token);
+            return FAILURE;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Reads a positive integer or a range of positive integers (MIN-MAX).
+ *
+ * @param text Text to be read.
+ * @param minimum Pointer to the integer where the lower bound will be stored.
+ * @param maximum Pointer to the integer where the upper bound will be stored.
+ * @return True, if a valid range was read, or false, otherwise.
+*/
+static bool parse_range(const char *text, int *minimum, int *maximum)
+{
+    char *end;
+
+    *minimum = strtol(text, &end, 10);
+    *maximum = *minimum;
+    if(*end == '-')
+        *maximum = strtol(end + 1, &end, 10);
+
+    return *end == '\0' && *minimum > 0 && *maximum >= *minimum;
+}
+
+/**
+ * Lists every accessible door allowed by the generator, ordered by width, side and offset.
+ *
+ * @param generator Generator whose placements will be listed.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status list_door_placements(Set_Generator generator)
+{
+    int capacity = 0;
+
+    for(int width = generator->min_width; width <= generator->max_width; width++)
+    {
+        for(enum Border_Side side = TOP_SIDE; side < WHOLE_BORDER; side++)
+        {
+            if(generator->side != WHOLE_BORDER && generator->side != side)
+                continue;
+
+            for(int offset = 0; offset + width <= get_side_length(side); offset++)
+            {
+                Door_Placement placement = {side, offset, width};
+                if(is_placement_accessible(placement) == false)
+                    continue;
+
+                if(generator->num_placements == capacity)
+                {
+                    capacity = capacity == 0 ? 64 : capacity * 2;
+
+                    Door_Placement *temp = realloc(generator->placements, sizeof(Door_Placement) * capacity);
+                    if(temp == NULL)
+                    {
+                        fprintf(stderr, "Failure in the allocation of the doors of a simulation set generator.\n");
+                        return FAILURE;
+                    }
+                    generator->placements = temp;
+                }
+
+                generator->placements[generator->num_placements] = placement;
+                generator->num_placements++;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Finds, for each symmetry of the environment, the placement that mirrors each listed placement.
+ *
+ * @param generator Generator whose mirrored placements will be found.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status find_mirrored_placements(Set_Generator generator)
+{
+    for(enum Symmetry symmetry = MIRRORED_COLUMNS; symmetry <= MIRRORED_BOTH; symmetry++)
+    {
+        if(is_environment_symmetric(symmetry) == false)
+            continue;
+
+        generator->mirrors[symmetry] = malloc(sizeof(int) * (generator->num_placements + 1));
+        if(generator->mirrors[symmetry] == NULL)
+        {
+            fprintf(stderr, "Failure in the allocation of the doors of a simulation set generator.\n");
+            return FAILURE;
+        }
+
+        for(int placement_index = 0; placement_index < generator->num_placements; placement_index++)
+        {
+            Door_Placement mirrored = mirror_placement(generator->placements[placement_index], symmetry);
+
+            generator->mirrors[symmetry][placement_index] = -1; // The mirrored door may be on a side outside of the generator.
+            for(int candidate = 0; candidate < generator->num_placements; candidate++)
+            {
+                Door_Placement current = generator->placements[candidate];
+                if(current.side == mirrored.side && current.offset == mirrored.offset && current.width == mirrored.width)
+                {
+                    generator->mirrors[symmetry][placement_index] = candidate;
+                    break;
+                }
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Returns the number of border cells available for doors along a side. The corners belong to the top and bottom sides.
+ *
+ * @param side Side of the border.
+ * @return The number of cells.
+*/
+static int get_side_length(enum Border_Side side)
+{
+    if(side == TOP_SIDE || side == BOTTOM_SIDE)
+        return cli_args.global_column_number;
+
+    return cli_args.global_line_number - 2;
+}
+
+/**
+ * Returns the coordinates of a cell of a door.
+ *
+ * @param placement Door.
+ * @param cell_index Index of the cell, between 0 and the width of the door.
+ * @return The Location of the cell.
+*/
+static Location get_placement_cell(Door_Placement placement, int cell_index)
+{
+    int position = placement.offset + cell_index;
+
+    if(placement.side == TOP_SIDE)
+        return (Location) {0, position};
+    else if(placement.side == BOTTOM_SIDE)
+        return (Location) {cli_args.global_line_number - 1, position};
+    else if(placement.side == LEFT_SIDE)
+        return (Location) {position + 1, 0};
+
+    return (Location) {position + 1, cli_args.global_column_number - 1};
+}
+
+/**
+ * Verifies if a door can be used: all of its cells must be walls and at least one of them must have a non-diagonal neighbor that isn't a wall (as verified for every exit when its static weights are calculated).
+ *
+ * @param placement Door to be verified.
+ * @return bool, where True indicates that the door is accessible.
+*/
+static bool is_placement_accessible(Door_Placement placement)
+{
+    bool accessible = false;
+
+    for(int cell_index = 0; cell_index < placement.width; cell_index++)
+    {
+        Location cell = get_placement_cell(placement, cell_index);
+        if(environment_only_grid[cell.lin][cell.col] != WALL_VALUE)
+            return false;
+
+        Location neighbors[4] = {{cell.lin - 1, cell.col}, {cell.lin + 1, cell.col}, {cell.lin, cell.col - 1}, {cell.lin, cell.col + 1}};
+        for(int neighbor_index = 0; neighbor_index < 4; neighbor_index++)
+        {
+            Location neighbor = neighbors[neighbor_index];
+            if(is_within_grid_lines(neighbor.lin) && is_within_grid_columns(neighbor.col) &&
+               environment_only_grid[neighbor.lin][neighbor.col] != WALL_VALUE)
+                accessible = true;
+        }
+    }
+
+    return accessible;
+}
+
+/**
+ * Verifies if the environment (structure and, when loaded from the file, pedestrians) is unchanged by the given symmetry.
+ *
+ * @param symmetry Symmetry to be verified.
+ * @return bool, where True indicates that the environment is symmetric.
+*/
+static bool is_environment_symmetric(enum Symmetry symmetry)
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    for(int i = 0; i < lines; i++)
+    {
+        int mirrored_i = symmetry == MIRRORED_COLUMNS ? i : lines - 1 - i;
+
+        for(int h = 0; h < columns; h++)
+        {
+            int mirrored_h = symmetry == MIRRORED_LINES ? h : columns - 1 - h;
+
+            if(environment_only_grid[i][h] != environment_only_grid[mirrored_i][mirrored_h])
+                return false;
+
+            if(origin_uses_static_pedestrians() &&
+               (pedestrian_position_grid[i][h] != 0) != (pedestrian_position_grid[mirrored_i][mirrored_h] != 0))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Returns the door that mirrors the given door under a symmetry of the environment.
+ *
+ * @param placement Door to be mirrored.
+ * @param symmetry Symmetry applied.
+ * @return The mirrored door.
+*/
+static Door_Placement mirror_placement(Door_Placement placement, enum Symmetry symmetry)
+{
+    Door_Placement mirrored = placement;
+    bool mirror_columns = symmetry == MIRRORED_COLUMNS || symmetry == MIRRORED_BOTH;
+    bool mirror_lines = symmetry == MIRRORED_LINES || symmetry == MIRRORED_BOTH;
+
+    if(placement.side == TOP_SIDE || placement.side == BOTTOM_SIDE)
+    {
+        if(mirror_lines)
+            mirrored.side = placement.side == TOP_SIDE ? BOTTOM_SIDE : TOP_SIDE;
+        if(mirror_columns)
+            mirrored.offset = get_side_length(placement.side) - placement.offset - placement.width;
+    }
+    else
+    {
+        if(mirror_columns)
+            mirrored.side = placement.side == LEFT_SIDE ? RIGHT_SIDE : LEFT_SIDE;
+        if(mirror_lines)
+            mirrored.offset = get_side_length(placement.side) - placement.offset - placement.width;
+    }
+
+    return mirrored;
+}
+
+/**
+ * Advances to the next combination of placements in lexicographic order, moving to combinations with one more door when the current number of doors is exhausted.
+ *
+ * @param generator Generator whose combination will be advanced.
+ * @return True, if there is a next combination, or false, otherwise.
+*/
+static bool advance_combination(Set_Generator generator)
+{
+    int doors = generator->current_doors;
+
+    if(doors > 0)
+    {
+        int index = doors - 1;
+        while(index >= 0 && generator->combination[index] == generator->num_placements - doors + index)
+            index--;
+
+        if(index >= 0)
+        {
+            generator->combination[index]++;
+            for(int next = index + 1; next < doors; next++)
+                generator->combination[next] = generator->combination[next - 1] + 1;
+
+            return true;
+        }
+    }
+
+    doors = doors == 0 ? generator->min_doors : doors + 1;
+    if(doors > generator->max_doors || doors > generator->num_placements)
+        return false;
+
+    generator->current_doors = doors;
+    for(int index = 0; index < doors; index++)
+        generator->combination[index] = index;
+
+    return true;
+}
+
+/**
+ * Advances to the next valid combination, which becomes the next simulation set of the generator.
+ *
+ * @param generator Generator whose combination will be advanced.
+ * @return True, if there is a next simulation set, or false, otherwise.
+*/
+static bool advance_set(Set_Generator generator)
+{
+    do
+    {
+        if(advance_combination(generator) == false)
+            return false;
+    }while(is_combination_valid(generator) == false);
+
+    generator->current_set++;
+
+    return true;
+}
+
+/**
+ * Verifies if the current combination has no overlapping doors and, for unique generators, if no mirror image of it precedes it in the enumeration.
+ *
+ * @param generator Generator whose combination will be verified.
+ * @return bool, where True indicates a valid combination.
+*/
+static bool is_combination_valid(Set_Generator generator)
+{
+    int doors = generator->current_doors;
+
+    for(int first = 0; first < doors; first++)
+    {
+        Door_Placement a = generator->placements[generator->combination[first]];
+
+        for(int second = first + 1; second < doors; second++)
+        {
+            Door_Placement b = generator->placements[generator->combination[second]];
+            if(a.side == b.side && a.offset < b.offset + b.width && b.offset < a.offset + a.width)
+                return false;
+        }
+    }
+
+    if(generator->unique == false)
+        return true;
+
+    int mirrored[doors];
+    for(int symmetry = 0; symmetry < GENERATOR_SYMMETRIES; symmetry++)
+    {
+        if(generator->mirrors[symmetry] == NULL)
+            continue;
+
+        bool complete = true;
+        for(int index = 0; index < doors; index++)
+        {
+            mirrored[index] = generator->mirrors[symmetry][generator->combination[index]];
+            if(mirrored[index] == -1)
+                complete = false;
+        }
+
+        if(complete == false)
+            continue;
+
+        qsort(mirrored, doors, sizeof(int), compare_indices);
+        for(int index = 0; index < doors; index++)
+        {
+            if(mirrored[index] != generator->combination[index])
+            {
+                if(mirrored[index] < generator->combination[index])
+                    return false; // The mirror image was already generated.
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Comparison function of placement indices for qsort.
+ *
+ * @param first Pointer to the first index.
+ * @param second Pointer to the second index.
+ * @return A negative, zero or positive integer, as the first index is smaller, equal or greater than the second.
+*/
+static int compare_indices(const void *first, const void *second)
+{
+    return *(const int *) first - *(const int *) second;
+}
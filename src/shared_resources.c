@@ -46,3 +46,14 @@ bool origin_uses_static_exits()
     return cli_args.environment_origin == STRUCTURE_AND_DOORS || 
            cli_args.environment_origin == STRUCTURE_DOORS_AND_PEDESTRIANS;
 }
+
+/**
+ * Verifies if the selected output is written in a binary format (trajectories and binary heatmaps).
+ * 
+ * @return bool, where True indicates that the output file must be opened in binary mode and False otherwise.
+*/
+bool is_output_binary()
+{
+    return cli_args.output_format == OUTPUT_TRAJECTORY || 
+           (cli_args.output_format == OUTPUT_HEATMAP && cli_args.heatmap_encoding == HEATMAP_BINARY);
+}
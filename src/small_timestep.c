@@ -0,0 +1,272 @@
+/*
+   File: small_timestep.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module holds the timestep variants of small environments, with at most SMALL_GRID_SIZE lines and columns (like most of the bundled environments). The final floor field and the conflicts are kept in fixed-size arrays, the floor field surrounded by a ring of walls, so the neighborhood scans need no bounds checks, and a timestep makes no heap allocation. The floor field is copied only when it changes, while the walls and occupied cells around each pedestrian are read from the bitboards of occupancy_bitboard.c, which are rebuilt at the start of each timestep, so the simulations of --batch-seeds can take turns. The variants follow the same steps as run_pedestrian_timestep, with the toggle options as constants, and the results are identical.
+*/
+
+#include<string.h>
+#include<stdbool.h>
+
+#include"../headers/cell.h"
+#include"../headers/exit.h"
+#include"../headers/grid.h"
+#include"../headers/heatmap.h"
+#include"../headers/pedestrian.h"
+#include"../headers/random_stream.h"
+#include"../headers/small_timestep.h"
+#include"../headers/occupancy_bitboard.h"
+#include"../headers/timestep_variants.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+// Cell of a small grid at the given coordinates of the environment; the ring of walls is at -1 and at the number of lines and columns.
+#define SMALL_CELL(grid, line, column) (grid)[(line) + 1][(column) + 1]
+
+#define SMALL_TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap) \
+    small_timestep_variant_##unoccupied_only##prevent_corner_crossing##immediate_exit##allow_X_movement##record_heatmap
+
+#define DEFINE_SMALL_TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap) \
+    static Function_Status SMALL_TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap)() \
+    { \
+        return run_small_timestep(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap); \
+    }
+
+#define LIST_SMALL_TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap) \
+    SMALL_TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap),
+
+static double small_floor_field[SMALL_GRID_SIZE + 2][SMALL_GRID_SIZE + 2];
+static int small_conflict_grid[SMALL_GRID_SIZE + 2][SMALL_GRID_SIZE + 2]; // Same encoding of the conflict_grid of identify_pedestrian_conflicts.
+static cell_conflict small_conflicts[SMALL_GRID_SIZE * SMALL_GRID_SIZE / 2]; // Every conflict has at least two pedestrians.
+static unsigned int small_floor_field_version = 0; // Version of the final floor field copied to small_floor_field (0 if none).
+
+static ALWAYS_INLINE Function_Status run_small_timestep(bool unoccupied_only, bool prevent_corner_crossing, bool immediate_exit, bool allow_X_movement, bool record_heatmap);
+static Function_Status load_small_grids();
+static ALWAYS_INLINE void evaluate_small_movement(Pedestrian current_pedestrian, bool unoccupied_only, bool prevent_corner_crossing);
+static int identify_small_conflicts();
+static ALWAYS_INLINE void move_small_pedestrian(Pedestrian current_pedestrian, bool immediate_exit);
+
+FOR_EACH_TIMESTEP_VARIANT(DEFINE_SMALL_TIMESTEP_VARIANT)
+
+static const Timestep_Function small_timestep_variants[] = {
+    FOR_EACH_TIMESTEP_VARIANT(LIST_SMALL_TIMESTEP_VARIANT)
+};
+
+/**
+ * Verifies if the environment fits in the arrays of the small environment timestep.
+ *
+ * @return bool, where True indicates that the environment has at most SMALL_GRID_SIZE lines and columns.
+*/
+bool is_small_environment()
+{
+    return cli_args.global_line_number <= SMALL_GRID_SIZE && cli_args.global_column_number <= SMALL_GRID_SIZE;
+}
+
+/**
+ * Returns the small environment timestep of the given combination of toggle options.
+ *
+ * @param variant_index Index of the combination, with the bits in the order of FOR_EACH_TIMESTEP_VARIANT.
+ * @return The timestep function.
+*/
+Timestep_Function get_small_timestep_variant(int variant_index)
+{
+    return small_timestep_variants[variant_index];
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Runs a timestep of the current simulation in the same steps as run_pedestrian_timestep, on the small grids and with the toggle options given as constants.
+ *
+ * @param unoccupied_only Opposite of cli_args.always_move_to_lowest.
+ * @param prevent_corner_crossing Value of cli_args.prevent_corner_crossing.
+ * @param immediate_exit Value of cli_args.immediate_exit.
+ * @param allow_X_movement Value of cli_args.allow_X_movement.
+ * @param record_heatmap Indicates that the output format is the heatmap.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static ALWAYS_INLINE Function_Status run_small_timestep(bool unoccupied_only, bool prevent_corner_crossing, bool immediate_exit, bool allow_X_movement, bool record_heatmap)
+{
+    if(load_small_grids() == FAILURE)
+        return FAILURE;
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+        evaluate_small_movement(pedestrian_set.list[p_index], unoccupied_only, prevent_corner_crossing);
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state != GOT_OUT && draw_pedestrian_panic(current_pedestrian))
+            current_pedestrian->in_panic = true;
+    }
+
+    if(! allow_X_movement)
+        block_bitboard_X_movement();
+
+    if(solve_pedestrian_conflicts(small_conflicts, identify_small_conflicts()) == FAILURE)
+        return FAILURE;
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+        move_small_pedestrian(pedestrian_set.list[p_index], immediate_exit);
+
+    for(int i = 0; i < cli_args.global_line_number; i++)
+        memset(pedestrian_position_grid[i], 0, sizeof(int) * cli_args.global_column_number);
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state == GOT_OUT)
+            continue;
+
+        pedestrian_position_grid[current_pedestrian->current.lin][current_pedestrian->current.col] = current_pedestrian->id;
+        if(record_heatmap)
+            record_heatmap_visit(current_pedestrian->current);
+    }
+
+    reset_pedestrian_state();
+    reset_pedestrian_panic();
+
+    return SUCCESS;
+}
+
+/**
+ * Copies the final floor field to the small grid, if it changed since the last copy, and prepares the bitboards.
+ *
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status load_small_grids()
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    if(small_floor_field_version != exits_set.final_floor_field_version)
+    {
+        for(int i = -1; i <= lines; i++)
+        {
+            for(int h = -1; h <= columns; h++)
+            {
+                bool is_ring = i == -1 || i == lines || h == -1 || h == columns;
+                SMALL_CELL(small_floor_field, i, h) = is_ring ? WALL_VALUE : exits_set.final_floor_field[i][h];
+            }
+        }
+
+        small_floor_field_version = exits_set.final_floor_field_version;
+    }
+
+    return prepare_neighbor_bitboards();
+}
+
+/**
+ * Determines the destination cell for the given pedestrian, as evaluate_pedestrian_movement and find_smallest_cell, on the small floor field and the bitboards.
+ *
+ * @param current_pedestrian The pedestrian whose movement will be evaluated.
+ * @param unoccupied_only Indicates that only unoccupied cells are considered.
+ * @param prevent_corner_crossing Indicates that diagonals through the corners of obstacles are blocked.
+*/
+static ALWAYS_INLINE void evaluate_small_movement(Pedestrian current_pedestrian, bool unoccupied_only, bool prevent_corner_crossing)
+{
+    if(current_pedestrian->state != MOVING || current_pedestrian->in_panic == true)
+        return;
+
+    int lin = current_pedestrian->current.lin, col = current_pedestrian->current.col;
+    Cell neighborhood[8];
+    int num_cells = 0;
+
+    // Free admissible neighbors, in the order scanned by find_smallest_cell.
+    Neighbor_Mask candidates = get_admissible_neighbors(current_pedestrian->current, prevent_corner_crossing);
+    if(unoccupied_only)
+        candidates &= ~get_neighbor_mask(occupancy_bitboard, current_pedestrian->current);
+
+    for(; candidates != 0; candidates &= candidates - 1)
+    {
+        int n_index = __builtin_ctz(candidates);
+        int neighbor_lin = lin + neighbor_offsets[n_index].lin, neighbor_col = col + neighbor_offsets[n_index].col;
+        neighborhood[num_cells++] = (Cell) {{neighbor_lin, neighbor_col}, SMALL_CELL(small_floor_field, neighbor_lin, neighbor_col)};
+    }
+
+    if(num_cells == 0)
+    {
+        current_pedestrian->state = STOPPED;
+        return;
+    }
+
+    insertion_sort(neighborhood, 0, num_cells - 1);
+
+    int same_value = 1; // Number of cells with the same floor field value.
+    while(same_value < num_cells && neighborhood[same_value].value == neighborhood[0].value)
+        same_value++;
+
+    int drawn_cell = draw_random_integer(current_pedestrian->id, TIE_BREAK_STREAM, same_value);
+    Location target = neighborhood[drawn_cell].coordinates;
+
+    if(is_bitboard_cell_set(occupancy_bitboard, target) == false)
+        current_pedestrian->target = target;
+    else
+        current_pedestrian->state = STOPPED; // The drawn cell is occupied.
+}
+
+/**
+ * Identifies the cells targeted by more than one pedestrian, as identify_pedestrian_conflicts, storing the conflicts in small_conflicts.
+ *
+ * @return The number of conflicts.
+*/
+static int identify_small_conflicts()
+{
+    int num_conflicts = 0;
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state != MOVING || current_pedestrian->in_panic == true)
+            continue;
+
+        int *target_cell = &SMALL_CELL(small_conflict_grid, current_pedestrian->target.lin, current_pedestrian->target.col);
+
+        if(*target_cell == 0)
+            *target_cell = current_pedestrian->id;
+        else if(*target_cell > 0)
+        {
+            small_conflicts[num_conflicts] = (cell_conflict) {2, {*target_cell, current_pedestrian->id}, 0};
+            num_conflicts++;
+            *target_cell = -num_conflicts;
+        }
+        else
+        {
+            Cell_Conflict current_conflict = &small_conflicts[-*target_cell - 1];
+            current_conflict->pedestrian_ids[current_conflict->num_pedestrians++] = current_pedestrian->id;
+        }
+    }
+
+    // Only the targeted cells were written, so only they are cleared for the next timestep.
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state == MOVING && current_pedestrian->in_panic == false)
+            SMALL_CELL(small_conflict_grid, current_pedestrian->target.lin, current_pedestrian->target.col) = 0;
+    }
+
+    return num_conflicts;
+}
+
+/**
+ * Moves the given pedestrian to their target location, or removes them from the environment, as move_pedestrian.
+ *
+ * @param current_pedestrian The pedestrian to be moved.
+ * @param immediate_exit Indicates that the pedestrians leave the environment as soon as they reach an exit.
+*/
+static ALWAYS_INLINE void move_small_pedestrian(Pedestrian current_pedestrian, bool immediate_exit)
+{
+    if(current_pedestrian->in_panic == true || current_pedestrian->state == GOT_OUT || current_pedestrian->state == STOPPED)
+        return;
+
+    if(current_pedestrian->state == MOVING)
+    {
+        current_pedestrian->current = current_pedestrian->target;
+
+        if(SMALL_CELL(small_floor_field, current_pedestrian->current.lin, current_pedestrian->current.col) == EXIT_VALUE)
+            current_pedestrian->state = immediate_exit ? GOT_OUT : LEAVING;
+    }
+    else if(current_pedestrian->state == LEAVING)
+        current_pedestrian->state = GOT_OUT;
+}
@@ -0,0 +1,168 @@
+/*
+   File: statistics.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module implements a streaming accumulator for the evacuation times of a simulation set. The mean and variance are kept with Welford's algorithm, while the quantiles are estimated from a fixed-size histogram whose bins widen as larger values are received.
+*/
+
+#include<math.h>
+#include<string.h>
+
+#include"../headers/statistics.h"
+#include"../headers/shared_resources.h"
+
+static void widen_histogram_bins(Streaming_Statistics *statistics);
+static double student_t_critical_value(int degrees_of_freedom);
+
+/**
+ * Resets the given accumulator, discarding all values previously added to it.
+ *
+ * @param statistics Accumulator to be reset.
+*/
+void reset_streaming_statistics(Streaming_Statistics *statistics)
+{
+    statistics->count = 0;
+    statistics->mean = 0.0;
+    statistics->sum_squared_deviations = 0.0;
+    statistics->minimum = -1;
+    statistics->maximum = -1;
+    statistics->bin_width = 1;
+    memset(statistics->histogram, 0, sizeof(statistics->histogram));
+}
+
+/**
+ * Adds a new non-negative value to the accumulator, updating the moments (Welford's algorithm), the extremes and the histogram.
+ *
+ * @note Negative values are ignored, as they aren't valid evacuation times.
+ *
+ * @param statistics Accumulator where the value will be added.
+ * @param value Value to be added.
+*/
+void add_streaming_statistics_value(Streaming_Statistics *statistics, int value)
+{
+    if(value < 0)
+        return;
+
+    statistics->count++;
+
+    double delta = value - statistics->mean;
+    statistics->mean += delta / statistics->count;
+    statistics->sum_squared_deviations += delta * (value - statistics->mean);
+
+    if(statistics->count == 1 || value < statistics->minimum)
+        statistics->minimum = value;
+    if(statistics->count == 1 || value > statistics->maximum)
+        statistics->maximum = value;
+
+    while(value / statistics->bin_width >= HISTOGRAM_BINS)
+        widen_histogram_bins(statistics);
+
+    statistics->histogram[value / statistics->bin_width]++;
+}
+
+/**
+ * Calculates the sample variance of the values added to the accumulator.
+ *
+ * @param statistics Accumulator from which the variance will be calculated.
+ * @return A double, representing the sample variance (zero when less than two values were added).
+*/
+double calculate_streaming_variance(Streaming_Statistics *statistics)
+{
+    if(statistics->count < 2)
+        return 0.0;
+
+    return statistics->sum_squared_deviations / (statistics->count - 1);
+}
+
+/**
+ * Estimates the requested quantile (nearest-rank definition) from the histogram of the accumulator.
+ *
+ * @note While every bin holds a single value (bin_width equals 1) the returned quantile is exact. Otherwise, the position within the selected bin is linearly interpolated.
+ *
+ * @param statistics Accumulator from which the quantile will be estimated.
+ * @param quantile A double between 0 and 1 (inclusive).
+ * @return A double, representing the estimated quantile, or -1 if the accumulator is empty.
+*/
+double calculate_streaming_quantile(Streaming_Statistics *statistics, double quantile)
+{
+    if(statistics->count == 0)
+        return -1;
+
+    int rank = (int) ceil(quantile * statistics->count);
+    if(rank < 1)
+        rank = 1;
+
+    int cumulative_count = 0;
+    for(int bin_index = 0; bin_index < HISTOGRAM_BINS; bin_index++)
+    {
+        int bin_count = statistics->histogram[bin_index];
+        if(cumulative_count + bin_count < rank)
+        {
+            cumulative_count += bin_count;
+            continue;
+        }
+
+        double estimate = bin_index * statistics->bin_width +
+                          (statistics->bin_width - 1) * (rank - cumulative_count) / (double) bin_count;
+
+        return fmax(statistics->minimum, fmin(statistics->maximum, estimate));
+    }
+
+    return statistics->maximum;
+}
+
+/**
+ * Calculates the half-width of the 95% confidence interval for the mean of a sample, using the Student's t distribution.
+ *
+ * @param count Number of values in the sample.
+ * @param variance Sample variance.
+ * @return A double, representing the half-width, or INFINITY when the sample has less than two values.
+*/
+double calculate_confidence_half_width(int count, double variance)
+{
+    if(count < 2)
+        return INFINITY;
+
+    return student_t_critical_value(count - 1) * sqrt(variance / count);
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Doubles the width of the histogram bins, merging each pair of adjacent bins into one.
+ *
+ * @param statistics Accumulator whose histogram will be widened.
+*/
+static void widen_histogram_bins(Streaming_Statistics *statistics)
+{
+    for(int bin_index = 0; bin_index < HISTOGRAM_BINS / 2; bin_index++)
+        statistics->histogram[bin_index] = statistics->histogram[2 * bin_index] + statistics->histogram[2 * bin_index + 1];
+
+    for(int bin_index = HISTOGRAM_BINS / 2; bin_index < HISTOGRAM_BINS; bin_index++)
+        statistics->histogram[bin_index] = 0;
+
+    statistics->bin_width *= 2;
+}
+
+/**
+ * Returns the two-sided 95% critical value of the Student's t distribution for the given degrees of freedom.
+ *
+ * @note Values up to 30 degrees of freedom are tabulated. Above that, the approximation 1.96 + 2.5 / df is used, which stays within 0.003 of the exact value.
+ *
+ * @param degrees_of_freedom A positive integer.
+ * @return A double, representing the critical value.
+*/
+static double student_t_critical_value(int degrees_of_freedom)
+{
+    static const double critical_values[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+         2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+         2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+    if(degrees_of_freedom <= 30)
+        return critical_values[degrees_of_freedom - 1];
+
+    return 1.96 + 2.5 / degrees_of_freedom;
+}
@@ -0,0 +1,186 @@
+/*
+   File: thread_pool.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module keeps a pool of cli_args.num_threads - 1 threads, started on the first use and reused until the end of the program, which run independent tasks (such as the calculations of each exit) along with the calling thread. The threads take the task indexes from a shared counter, so tasks of different lengths are balanced between them.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+#include<pthread.h>
+#include<stdatomic.h>
+
+#include"../headers/thread_pool.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static pthread_t *pool_threads = NULL;
+static int num_pool_threads = 0;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_available = PTHREAD_COND_INITIALIZER; // Signaled when a new group of tasks is available (or the pool is finishing).
+static pthread_cond_t work_done = PTHREAD_COND_INITIALIZER; // Signaled when the last task of a group finishes or the last active thread leaves it.
+
+// The following fields describe the current group of tasks and are only changed with the pool_lock held.
+static Pool_Task current_task = NULL;
+static Function_Status *current_statuses = NULL;
+static int current_num_tasks = 0;
+static unsigned int current_group = 0; // Incremented for each new group of tasks.
+static int num_pending_tasks = 0; // Tasks of the current group that haven't finished.
+static int num_active_threads = 0; // Pool threads working on the current group.
+static bool is_pool_finishing = false;
+
+static atomic_int next_task_index; // Next task of the current group to be taken.
+
+static void start_thread_pool();
+static void *run_pool_thread(void *argument);
+static void take_pool_tasks(Pool_Task task, int num_tasks, Function_Status *task_statuses);
+
+/**
+ * Runs the tasks from 0 to num_tasks - 1 on the thread pool, returning when all of them have finished. The calling thread also runs tasks, and the tasks run sequentially when the pool couldn't be started.
+ *
+ * @param task Function called with the index of each task.
+ * @param num_tasks Number of tasks.
+ * @param task_statuses Array where the status returned by each task will be stored, indexed by task.
+*/
+void run_pool_tasks(Pool_Task task, int num_tasks, Function_Status *task_statuses)
+{
+    if(pool_threads == NULL)
+        start_thread_pool();
+
+    pthread_mutex_lock(&pool_lock);
+
+    // A thread that woke up late for the previous group may still be taking task indexes.
+    while(num_active_threads > 0)
+        pthread_cond_wait(&work_done, &pool_lock);
+
+    current_task = task;
+    current_statuses = task_statuses;
+    current_num_tasks = num_tasks;
+    num_pending_tasks = num_tasks;
+    atomic_store(&next_task_index, 0);
+    current_group++;
+
+    pthread_cond_broadcast(&work_available);
+    pthread_mutex_unlock(&pool_lock);
+
+    take_pool_tasks(task, num_tasks, task_statuses);
+
+    pthread_mutex_lock(&pool_lock);
+    while(num_pending_tasks > 0)
+        pthread_cond_wait(&work_done, &pool_lock);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+/**
+ * Finishes the threads of the pool.
+*/
+void deallocate_thread_pool()
+{
+    if(pool_threads == NULL)
+        return;
+
+    pthread_mutex_lock(&pool_lock);
+    is_pool_finishing = true;
+    pthread_cond_broadcast(&work_available);
+    pthread_mutex_unlock(&pool_lock);
+
+    for(int thread_index = 0; thread_index < num_pool_threads; thread_index++)
+        pthread_join(pool_threads[thread_index], NULL);
+
+    free(pool_threads);
+    pool_threads = NULL;
+    num_pool_threads = 0;
+    is_pool_finishing = false;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Starts the threads of the pool. If some of them can't be started, the pool continues with the ones that were.
+*/
+static void start_thread_pool()
+{
+    pool_threads = malloc(sizeof(pthread_t) * (cli_args.num_threads > 1 ? cli_args.num_threads - 1 : 1));
+    if(pool_threads == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the thread pool. The tasks will run sequentially.\n");
+        return;
+    }
+
+    for(int thread_index = 0; thread_index < cli_args.num_threads - 1; thread_index++)
+    {
+        if(pthread_create(&pool_threads[thread_index], NULL, run_pool_thread, NULL) != 0)
+        {
+            fprintf(stderr, "It was only possible to start %d threads for the thread pool.\n", num_pool_threads);
+            break;
+        }
+        num_pool_threads++;
+    }
+}
+
+/**
+ * Body of each thread of the pool: waits for a new group of tasks and takes tasks from it, until the pool is finishing.
+ *
+ * @param argument Unused.
+ * @return Always NULL.
+*/
+static void *run_pool_thread(void *argument)
+{
+    (void) argument;
+
+    unsigned int last_group = 0;
+
+    pthread_mutex_lock(&pool_lock);
+    while(true)
+    {
+        while(current_group == last_group && is_pool_finishing == false)
+            pthread_cond_wait(&work_available, &pool_lock);
+
+        if(is_pool_finishing)
+            break;
+
+        // The group is read with the lock held, so it can't be replaced while this thread is active.
+        last_group = current_group;
+        Pool_Task task = current_task;
+        Function_Status *task_statuses = current_statuses;
+        int num_tasks = current_num_tasks;
+        num_active_threads++;
+        pthread_mutex_unlock(&pool_lock);
+
+        take_pool_tasks(task, num_tasks, task_statuses);
+
+        pthread_mutex_lock(&pool_lock);
+        num_active_threads--;
+        if(num_active_threads == 0)
+            pthread_cond_broadcast(&work_done);
+    }
+    pthread_mutex_unlock(&pool_lock);
+
+    return NULL;
+}
+
+/**
+ * Takes and runs tasks of the current group until there are no more tasks to be taken.
+ *
+ * @param task Function called with the index of each task.
+ * @param num_tasks Number of tasks of the group.
+ * @param task_statuses Array where the status returned by each task will be stored.
+*/
+static void take_pool_tasks(Pool_Task task, int num_tasks, Function_Status *task_statuses)
+{
+    int task_index;
+    while((task_index = atomic_fetch_add(&next_task_index, 1)) < num_tasks)
+    {
+        task_statuses[task_index] = task(task_index);
+
+        pthread_mutex_lock(&pool_lock);
+        num_pending_tasks--;
+        if(num_pending_tasks == 0)
+            pthread_cond_broadcast(&work_done);
+        pthread_mutex_unlock(&pool_lock);
+    }
+}
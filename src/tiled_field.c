@@ -0,0 +1,253 @@
+/*
+   File: tiled_field.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module calculates the static weights of a single exit on grids stored in tiles (--grid-layout=tiled), for large environments. The sweeps of calculate_static_weight read three lines of the grid for every cell, which are far apart in memory once the lines have thousands of cells; in a Tiled_Grid, the neighborhoods of the cells of a tile fall in the tile and its adjacent tiles. The grids are surrounded by a ring of walls, so the sweeps need no bounds checks, and a tile is only swept if one of its values changed in the previous sweep, since the values it offers to its neighbors were already taken otherwise. The results are identical to those of calculate_static_weight.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/tiled_field.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+typedef struct{
+    Tiled_Grid static_weight; // Cell (i, h) of the environment is the cell (i + 1, h + 1) of the tiled grids.
+    Tiled_Grid auxiliary_grid; // Stores the values of the next sweep.
+    bool *tile_changed[2]; // Indicates, for each tile, if any of its values changed in the previous and in the current sweep.
+    int tile_lines;
+    double floor_field_rule[3][3];
+} Tiled_Context;
+
+static void load_tiled_static_weight(Tiled_Context *context, Exit current_exit);
+static Function_Status store_sparse_static_weight(Tiled_Context *context, Sparse_Grid *static_weight);
+static bool sweep_tile(Tiled_Context *context, int tile_line, int tile_column);
+static bool is_tiled_diagonal_valid(Tiled_Grid floor_field, int line, int column, int j, int k);
+
+/**
+ * Calculates the static weights for the given exit on tiled grids. The static weight grid must be already initialized, as in calculate_static_weight.
+ *
+ * @param current_exit Exit for which the static weights will be calculated.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status calculate_tiled_static_weight(Exit current_exit)
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    Tiled_Context context = {
+        .static_weight = allocate_tiled_grid(lines + 2, columns + 2),
+        .auxiliary_grid = allocate_tiled_grid(lines + 2, columns + 2),
+        .tile_lines = (lines + 2 + TILE_SIDE - 1) / TILE_SIDE,
+        .floor_field_rule = {{cli_args.diagonal,    1.0,    cli_args.diagonal},
+                             {       1.0,           0.0,           1.0       },
+                             {cli_args.diagonal,    1.0,    cli_args.diagonal}}
+    };
+
+    int num_tiles = context.tile_lines * context.static_weight.tile_columns;
+    context.tile_changed[0] = malloc(sizeof(bool) * num_tiles);
+    context.tile_changed[1] = malloc(sizeof(bool) * num_tiles);
+
+    Function_Status status = SUCCESS;
+    if(context.static_weight.cells == NULL || context.auxiliary_grid.cells == NULL || context.tile_changed[0] == NULL || context.tile_changed[1] == NULL)
+    {
+        fprintf(stderr, "Failure to allocate the structures at calculate_tiled_static_weight.\n");
+        status = FAILURE;
+        goto cleanup;
+    }
+
+    load_tiled_static_weight(&context, current_exit);
+    memcpy(context.auxiliary_grid.cells, context.static_weight.cells, sizeof(double) * num_tiles * TILE_SIDE * TILE_SIDE);
+
+    for(int tile_index = 0; tile_index < num_tiles; tile_index++)
+        context.tile_changed[0][tile_index] = true; // The first sweep visits every tile.
+
+    bool has_changed;
+    do
+    {
+        has_changed = false;
+        memset(context.tile_changed[1], false, sizeof(bool) * num_tiles);
+
+        for(int tile_index = 0; tile_index < num_tiles; tile_index++)
+        {
+            if(context.tile_changed[0][tile_index])
+                has_changed |= sweep_tile(&context, tile_index / context.static_weight.tile_columns, tile_index % context.static_weight.tile_columns);
+        }
+
+        // Only the tiles that changed differ between the grids.
+        for(int tile_index = 0; tile_index < num_tiles; tile_index++)
+        {
+            if(context.tile_changed[1][tile_index])
+                memcpy(&context.static_weight.cells[tile_index * TILE_SIDE * TILE_SIDE], &context.auxiliary_grid.cells[tile_index * TILE_SIDE * TILE_SIDE], sizeof(double) * TILE_SIDE * TILE_SIDE);
+        }
+
+        bool *swap = context.tile_changed[0];
+        context.tile_changed[0] = context.tile_changed[1];
+        context.tile_changed[1] = swap;
+    }
+    while(has_changed);
+
+    if(current_exit->sparse_static_weight != NULL)
+        status = store_sparse_static_weight(&context, current_exit->sparse_static_weight);
+    else
+    {
+        for(int i = 0; i < lines; i++)
+        {
+            for(int h = 0; h < columns; h++)
+                current_exit->static_weight[i][h] = TILED_CELL(context.static_weight, i + 1, h + 1);
+        }
+    }
+
+cleanup:
+    deallocate_tiled_grid(&context.static_weight);
+    deallocate_tiled_grid(&context.auxiliary_grid);
+    free(context.tile_changed[0]);
+    free(context.tile_changed[1]);
+
+    return status;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Copies the initial static weights of the given exit to the tiled static weight grid, surrounded by the ring of walls. The sparse static weights are initialized here, as in initialize_static_weight_grid, since they aren't materialized before the calculation.
+ *
+ * @param context Context of the calculation.
+ * @param current_exit Exit for which the static weights will be calculated.
+*/
+static void load_tiled_static_weight(Tiled_Context *context, Exit current_exit)
+{
+    int lines = cli_args.global_line_number, columns = cli_args.global_column_number;
+
+    for(int i = -1; i <= lines; i++)
+    {
+        for(int h = -1; h <= columns; h++)
+        {
+            double cell_value;
+            if(i == -1 || i == lines || h == -1 || h == columns)
+                cell_value = WALL_VALUE;
+            else if(current_exit->static_weight != NULL)
+                cell_value = current_exit->static_weight[i][h];
+            else
+                cell_value = environment_only_grid[i][h] == WALL_VALUE ? WALL_VALUE : 0.0;
+
+            TILED_CELL(context->static_weight, i + 1, h + 1) = cell_value;
+        }
+    }
+
+    if(current_exit->static_weight == NULL)
+    {
+        for(int i = 0; i < current_exit->width; i++)
+            TILED_CELL(context->static_weight, current_exit->coordinates[i].lin + 1, current_exit->coordinates[i].col + 1) = EXIT_VALUE;
+    }
+}
+
+/**
+ * Copies the calculated static weights to a sparse grid, materializing only the tiles with at least one cell reachable from the exit. The other cells are walls or unreachable cells, which keep a static weight of zero.
+ *
+ * @param context Context of the calculation.
+ * @param static_weight Sparse grid where the static weights will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status store_sparse_static_weight(Tiled_Context *context, Sparse_Grid *static_weight)
+{
+    static_weight->wall_value = WALL_VALUE;
+    static_weight->background_value = 0.0;
+
+    for(int pass = 0; pass < 2; pass++)
+    {
+        for(int i = 0; i < cli_args.global_line_number; i++)
+        {
+            for(int h = 0; h < cli_args.global_column_number; h++)
+            {
+                double cell_value = TILED_CELL(context->static_weight, i + 1, h + 1);
+                int tile_index = (i >> TILE_SHIFT) * static_weight->tile_columns + (h >> TILE_SHIFT);
+
+                if(pass == 0 && cell_value != WALL_VALUE && cell_value != 0.0 && materialize_sparse_tile(static_weight, tile_index) == NULL)
+                    return FAILURE; // The first pass materializes the reachable tiles, and the second one fills them.
+                else if(pass == 1 && static_weight->tiles[tile_index] != NULL)
+                    static_weight->tiles[tile_index][((i & (TILE_SIDE - 1)) << TILE_SHIFT) + (h & (TILE_SIDE - 1))] = cell_value;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Lowers the values of the neighbors of each cell of the given tile in the auxiliary grid, with the rules of calculate_static_weight, marking the tiles whose values changed.
+ *
+ * @param context Context of the calculation.
+ * @param tile_line Line of the tile.
+ * @param tile_column Column of the tile.
+ * @return bool, where True indicates that at least one value changed.
+*/
+static bool sweep_tile(Tiled_Context *context, int tile_line, int tile_column)
+{
+    Tiled_Grid static_weight = context->static_weight;
+    Tiled_Grid auxiliary_grid = context->auxiliary_grid;
+    bool has_changed = false;
+
+    for(int i = tile_line * TILE_SIDE; i < (tile_line + 1) * TILE_SIDE; i++)
+    {
+        for(int h = tile_column * TILE_SIDE; h < (tile_column + 1) * TILE_SIDE; h++)
+        {
+            double current_cell_value = TILED_CELL(static_weight, i, h);
+
+            // The ring of walls and the cells that complete the last tiles (zero) are skipped too.
+            if(current_cell_value == WALL_VALUE || current_cell_value == 0.0)
+                continue;
+
+            for(int j = -1; j < 2; j++)
+            {
+                for(int k = -1; k < 2; k++)
+                {
+                    double adjacent_static_value = TILED_CELL(static_weight, i + j, h + k);
+                    if(adjacent_static_value == WALL_VALUE || adjacent_static_value == EXIT_VALUE || (j == 0 && k == 0))
+                        continue;
+
+                    if(j != 0 && k != 0 && ! is_tiled_diagonal_valid(static_weight, i, h, j, k))
+                        continue;
+
+                    double adjacent_cell_value = current_cell_value + context->floor_field_rule[1 + j][1 + k];
+                    double *auxiliary_cell = &TILED_CELL(auxiliary_grid, i + j, h + k);
+                    if(*auxiliary_cell == 0.0 || adjacent_cell_value < *auxiliary_cell)
+                    {
+                        *auxiliary_cell = adjacent_cell_value;
+                        context->tile_changed[1][((i + j) >> TILE_SHIFT) * static_weight.tile_columns + ((h + k) >> TILE_SHIFT)] = true;
+                        has_changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return has_changed;
+}
+
+/**
+ * Verifies if the diagonal movement from the given cell is valid, as is_diagonal_valid, on a tiled grid with a ring of walls.
+ *
+ * @param floor_field Tiled grid where the walls and obstacles are identified.
+ * @param line Line of the origin cell in the tiled grid.
+ * @param column Column of the origin cell in the tiled grid.
+ * @param j Line direction of the movement.
+ * @param k Column direction of the movement.
+ * @return bool, where True indicates that the diagonal can be crossed.
+*/
+static bool is_tiled_diagonal_valid(Tiled_Grid floor_field, int line, int column, int j, int k)
+{
+    bool is_vertical_blocked = TILED_CELL(floor_field, line + j, column) == WALL_VALUE;
+    bool is_horizontal_blocked = TILED_CELL(floor_field, line, column + k) == WALL_VALUE;
+
+    if(cli_args.prevent_corner_crossing)
+        return ! is_vertical_blocked && ! is_horizontal_blocked;
+
+    return ! (is_vertical_blocked && is_horizontal_blocked);
+}
@@ -0,0 +1,240 @@
+/*
+   File: timestep_variants.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module holds specialized variants of the sequential timestep, one for each combination of the toggle options checked inside the loops over the pedestrians and their neighborhoods (--always-to-lowest, --avoid-corner-movement, --immediate-exit, --allow-x-movement and the heatmap output). Every variant is generated from the same inlined timestep, with the options as constants, so the compiler removes their branches from the loops. The variant is selected once per run; the debug information is only printed by the generic timestep (run_pedestrian_timestep), which is used with the --debug option.
+*/
+
+#include<stdlib.h>
+#include<stdbool.h>
+
+#include"../headers/cell.h"
+#include"../headers/exit.h"
+#include"../headers/grid.h"
+#include"../headers/heatmap.h"
+#include"../headers/pedestrian.h"
+#include"../headers/random_stream.h"
+#include"../headers/parallel_timestep.h"
+#include"../headers/small_timestep.h"
+#include"../headers/occupancy_bitboard.h"
+#include"../headers/timestep_variants.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+// Names the variant of the given options, each being 0 or 1.
+#define TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap) \
+    timestep_variant_##unoccupied_only##prevent_corner_crossing##immediate_exit##allow_X_movement##record_heatmap
+
+#define DEFINE_TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap) \
+    static Function_Status TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap)() \
+    { \
+        return run_specialized_timestep(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap); \
+    }
+
+#define LIST_TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap) \
+    TIMESTEP_VARIANT(unoccupied_only, prevent_corner_crossing, immediate_exit, allow_X_movement, record_heatmap),
+
+Timestep_Function run_timestep = run_pedestrian_timestep;
+
+static ALWAYS_INLINE Function_Status run_specialized_timestep(bool unoccupied_only, bool prevent_corner_crossing, bool immediate_exit, bool allow_X_movement, bool record_heatmap);
+static ALWAYS_INLINE void evaluate_specialized_movement(Pedestrian current_pedestrian, bool unoccupied_only, bool prevent_corner_crossing);
+static ALWAYS_INLINE void move_specialized_pedestrian(Pedestrian current_pedestrian, bool immediate_exit);
+
+FOR_EACH_TIMESTEP_VARIANT(DEFINE_TIMESTEP_VARIANT)
+
+static const Timestep_Function timestep_variants[] = {
+    FOR_EACH_TIMESTEP_VARIANT(LIST_TIMESTEP_VARIANT)
+};
+
+/**
+ * Selects the timestep used by the simulations for the options of the run: the parallel timestep, the generic timestep (with debug information) or the specialized variant of the toggle options, which uses the small grids of small_timestep.c in small environments.
+ *
+ * @note Must be called after the dimensions of the environment are known.
+*/
+void select_timestep_variant()
+{
+    if(cli_args.parallel_timestep)
+        run_timestep = run_parallel_timestep;
+    else if(cli_args.show_debug_information)
+        run_timestep = run_pedestrian_timestep;
+    else
+    {
+        int variant_index = (! cli_args.always_move_to_lowest) << 4 | cli_args.prevent_corner_crossing << 3 | cli_args.immediate_exit << 2 |
+                            cli_args.allow_X_movement << 1 | (cli_args.output_format == OUTPUT_HEATMAP);
+        run_timestep = is_small_environment() ? get_small_timestep_variant(variant_index) : timestep_variants[variant_index];
+    }
+}
+
+/**
+ * Finds and solves the X movements between adjacent pedestrians, as block_X_movement, visiting only the occupied cells of the occupancy bitboard, in the same order.
+ *
+ * @note The occupancy bitboard must match pedestrian_position_grid (see prepare_neighbor_bitboards).
+*/
+void block_bitboard_X_movement()
+{
+    for(int i = 1; i < cli_args.global_line_number - 1; i++)
+    {
+        const uint64_t *bitboard_line = occupancy_bitboard + (size_t) (i + 1) * bitboard_words_per_line;
+
+        for(int word = 0; word < bitboard_words_per_line; word++)
+        {
+            for(uint64_t occupied = bitboard_line[word]; occupied != 0; occupied &= occupied - 1)
+            {
+                int h = word * 64 + __builtin_ctzll(occupied) - 1; // The bit 0 is the ring around the environment.
+                if(h < 1 || h >= cli_args.global_column_number - 1)
+                    continue;
+
+                Pedestrian first_pedestrian = pedestrian_set.list[pedestrian_position_grid[i][h] - 1];
+                if(first_pedestrian->state != MOVING || first_pedestrian->in_panic == true)
+                    continue;
+
+                int second_pedestrian_id = pedestrian_position_grid[i][h + 1];
+                if(second_pedestrian_id > 0 && are_pedestrian_paths_crossing(first_pedestrian, pedestrian_set.list[second_pedestrian_id - 1]))
+                {
+                    solve_X_movement(first_pedestrian, pedestrian_set.list[second_pedestrian_id - 1]);
+                    continue;
+                }
+
+                second_pedestrian_id = pedestrian_position_grid[i + 1][h];
+                if(second_pedestrian_id > 0 && are_pedestrian_paths_crossing(first_pedestrian, pedestrian_set.list[second_pedestrian_id - 1]))
+                    solve_X_movement(first_pedestrian, pedestrian_set.list[second_pedestrian_id - 1]);
+            }
+        }
+    }
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Runs a timestep of the current simulation in the same steps as run_pedestrian_timestep, with the toggle options given as constants.
+ *
+ * @param unoccupied_only Opposite of cli_args.always_move_to_lowest.
+ * @param prevent_corner_crossing Value of cli_args.prevent_corner_crossing.
+ * @param immediate_exit Value of cli_args.immediate_exit.
+ * @param allow_X_movement Value of cli_args.allow_X_movement.
+ * @param record_heatmap Indicates that the output format is the heatmap.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static ALWAYS_INLINE Function_Status run_specialized_timestep(bool unoccupied_only, bool prevent_corner_crossing, bool immediate_exit, bool allow_X_movement, bool record_heatmap)
+{
+    if(prepare_neighbor_bitboards() == FAILURE)
+        return FAILURE;
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+        evaluate_specialized_movement(pedestrian_set.list[p_index], unoccupied_only, prevent_corner_crossing);
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state != GOT_OUT && draw_pedestrian_panic(current_pedestrian))
+            current_pedestrian->in_panic = true;
+    }
+
+    if(! allow_X_movement)
+        block_bitboard_X_movement();
+
+    Cell_Conflict pedestrian_conflicts = NULL;
+    int num_conflicts = 0;
+
+    if(identify_pedestrian_conflicts(&pedestrian_conflicts, &num_conflicts) == FAILURE)
+        return FAILURE;
+
+    Function_Status status = solve_pedestrian_conflicts(pedestrian_conflicts, num_conflicts);
+    free(pedestrian_conflicts);
+    if(status == FAILURE)
+        return FAILURE;
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+        move_specialized_pedestrian(pedestrian_set.list[p_index], immediate_exit);
+
+    reset_integer_grid(pedestrian_position_grid, cli_args.global_line_number, cli_args.global_column_number);
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        if(current_pedestrian->state == GOT_OUT)
+            continue;
+
+        pedestrian_position_grid[current_pedestrian->current.lin][current_pedestrian->current.col] = current_pedestrian->id;
+        if(record_heatmap)
+            record_heatmap_visit(current_pedestrian->current);
+    }
+
+    reset_pedestrian_state();
+    reset_pedestrian_panic();
+
+    return SUCCESS;
+}
+
+/**
+ * Determines the destination cell for the given pedestrian, as evaluate_pedestrian_movement and find_smallest_cell, with the neighborhood kept on the stack and the walls and occupied cells read from the bitboards.
+ *
+ * @param current_pedestrian The pedestrian whose movement will be evaluated.
+ * @param unoccupied_only Indicates that only unoccupied cells are considered.
+ * @param prevent_corner_crossing Indicates that diagonals through the corners of obstacles are blocked.
+*/
+static ALWAYS_INLINE void evaluate_specialized_movement(Pedestrian current_pedestrian, bool unoccupied_only, bool prevent_corner_crossing)
+{
+    if(current_pedestrian->state != MOVING || current_pedestrian->in_panic == true)
+        return;
+
+    Location cell_coordinates = current_pedestrian->current;
+
+    // Free admissible neighbors, in the order scanned by find_smallest_cell.
+    Neighbor_Mask candidates = get_admissible_neighbors(cell_coordinates, prevent_corner_crossing);
+    if(unoccupied_only)
+        candidates &= ~get_neighbor_mask(occupancy_bitboard, cell_coordinates);
+
+    Cell neighborhood[8];
+    int num_cells = 0;
+
+    for(; candidates != 0; candidates &= candidates - 1)
+    {
+        int n_index = __builtin_ctz(candidates);
+        Location neighbor = {cell_coordinates.lin + neighbor_offsets[n_index].lin, cell_coordinates.col + neighbor_offsets[n_index].col};
+        neighborhood[num_cells++] = (Cell) {neighbor, exits_set.final_floor_field[neighbor.lin][neighbor.col]};
+    }
+
+    if(num_cells == 0)
+    {
+        current_pedestrian->state = STOPPED;
+        return;
+    }
+
+    insertion_sort(neighborhood, 0, num_cells - 1);
+
+    int same_value = 1; // Number of cells with the same floor field value.
+    while(same_value < num_cells && neighborhood[same_value].value == neighborhood[0].value)
+        same_value++;
+
+    int drawn_cell = draw_random_integer(current_pedestrian->id, TIE_BREAK_STREAM, same_value);
+    Location target = neighborhood[drawn_cell].coordinates;
+
+    if(is_bitboard_cell_set(occupancy_bitboard, target) == false)
+        current_pedestrian->target = target;
+    else
+        current_pedestrian->state = STOPPED; // The drawn cell is occupied.
+}
+
+/**
+ * Moves the given pedestrian to their target location, or removes them from the environment, as move_pedestrian.
+ *
+ * @param current_pedestrian The pedestrian to be moved.
+ * @param immediate_exit Indicates that the pedestrians leave the environment as soon as they reach an exit.
+*/
+static ALWAYS_INLINE void move_specialized_pedestrian(Pedestrian current_pedestrian, bool immediate_exit)
+{
+    if(current_pedestrian->in_panic == true || current_pedestrian->state == GOT_OUT || current_pedestrian->state == STOPPED)
+        return;
+
+    if(current_pedestrian->state == MOVING)
+    {
+        current_pedestrian->current = current_pedestrian->target;
+
+        if(exits_set.final_floor_field[current_pedestrian->current.lin][current_pedestrian->current.col] == EXIT_VALUE)
+            current_pedestrian->state = immediate_exit ? GOT_OUT : LEAVING;
+    }
+    else if(current_pedestrian->state == LEAVING)
+        current_pedestrian->state = GOT_OUT;
+}
@@ -0,0 +1,263 @@
+/*
+   File: trajectory.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module records the simulations in a compact binary trajectory format: the environment is written once, followed by the exits of each simulation set, the initial position of the pedestrians of each simulation and, for each timestep, only the movements and exits of the pedestrians. The format is described in trajectory.h and can be read by the replay tool.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+
+#include"../headers/grid.h"
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/trajectory.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static Location *recorded_locations = NULL; // Last recorded location of each pedestrian, indexed by id - 1.
+static bool *recorded_presence = NULL; // Whether each pedestrian, indexed by id - 1, was still in the environment at the last record.
+static int num_recorded_pedestrians = 0;
+
+static unsigned char *event_buffer = NULL; // Events of the current timestep, written at once after being counted.
+static int event_buffer_length = 0;
+static int event_buffer_capacity = 0;
+
+static Function_Status append_event(unsigned int id_gap, unsigned char event_code);
+
+/**
+ * Writes the trajectory header (magic, version, full command and dimensions) and the structure of the environment.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status write_trajectory_header(FILE *output_stream)
+{
+    if(output_stream == NULL)
+    {
+        fprintf(stderr, "No valid stream was provided at write_trajectory_header.\n");
+        return FAILURE;
+    }
+
+    fwrite(TRAJECTORY_MAGIC, 1, strlen(TRAJECTORY_MAGIC), output_stream);
+    write_varint(output_stream, TRAJECTORY_VERSION);
+
+    int command_length = strlen(cli_args.full_command);
+    write_varint(output_stream, command_length);
+    fwrite(cli_args.full_command, 1, command_length, output_stream);
+
+    write_varint(output_stream, cli_args.global_line_number);
+    write_varint(output_stream, cli_args.global_column_number);
+
+    for(int i = 0; i < cli_args.global_line_number; i++)
+    {
+        for(int h = 0; h < cli_args.global_column_number; h++)
+            fputc(environment_only_grid[i][h] == WALL_VALUE ? TRAJECTORY_WALL_CELL : TRAJECTORY_EMPTY_CELL, output_stream);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Writes a record with the exit cells of the current simulation set.
+ *
+ * @param output_stream Stream where the data will be written.
+*/
+void write_trajectory_set(FILE *output_stream)
+{
+    int num_exit_cells = 0;
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+        num_exit_cells += exits_set.list[exit_index]->width;
+
+    fputc(TRAJECTORY_SET, output_stream);
+    write_varint(output_stream, num_exit_cells);
+
+    for(int exit_index = 0; exit_index < exits_set.num_exits; exit_index++)
+    {
+        Exit current_exit = exits_set.list[exit_index];
+        for(int cell_index = 0; cell_index < current_exit->width; cell_index++)
+        {
+            write_varint(output_stream, current_exit->coordinates[cell_index].lin);
+            write_varint(output_stream, current_exit->coordinates[cell_index].col);
+        }
+    }
+}
+
+/**
+ * Writes a record with the initial position of every pedestrian of a new simulation.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param simulation_index Index of the simulation within the simulation set.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+Function_Status write_trajectory_simulation_start(FILE *output_stream, int simulation_index)
+{
+    if(pedestrian_set.num_pedestrians > num_recorded_pedestrians)
+    {
+        Location *new_locations = realloc(recorded_locations, sizeof(Location) * pedestrian_set.num_pedestrians);
+        bool *new_presence = realloc(recorded_presence, sizeof(bool) * pedestrian_set.num_pedestrians);
+        if(new_locations == NULL || new_presence == NULL)
+        {
+            fprintf(stderr, "Failure in the realloc of the recorded pedestrian locations.\n");
+            free(new_locations != NULL ? new_locations : recorded_locations);
+            free(new_presence != NULL ? new_presence : recorded_presence);
+            recorded_locations = NULL;
+            recorded_presence = NULL;
+            num_recorded_pedestrians = 0;
+            return FAILURE;
+        }
+
+        recorded_locations = new_locations;
+        recorded_presence = new_presence;
+    }
+    num_recorded_pedestrians = pedestrian_set.num_pedestrians;
+
+    fputc(TRAJECTORY_SIMULATION, output_stream);
+    write_varint(output_stream, simulation_index);
+    write_varint(output_stream, pedestrian_set.num_pedestrians);
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Location current = pedestrian_set.list[p_index]->current;
+
+        write_varint(output_stream, current.lin);
+        write_varint(output_stream, current.col);
+
+        recorded_locations[p_index] = current;
+        recorded_presence[p_index] = true;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Writes a record with the movements and exits of the pedestrians since the last recorded timestep.
+ *
+ * @param output_stream Stream where the data will be written.
+*/
+void write_trajectory_timestep(FILE *output_stream)
+{
+    int previous_id = 0;
+    int num_events = 0;
+
+    event_buffer_length = 0;
+
+    for(int p_index = 0; p_index < num_recorded_pedestrians; p_index++)
+    {
+        if(recorded_presence[p_index] == false)
+            continue;
+
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+        Location previous = recorded_locations[p_index];
+        Location current = current_pedestrian->current;
+
+        if(previous.lin != current.lin || previous.col != current.col)
+        {
+            unsigned char direction = (current.lin - previous.lin + 1) * 3 + (current.col - previous.col + 1);
+            if(append_event(current_pedestrian->id - previous_id, direction) == FAILURE)
+                return;
+
+            previous_id = current_pedestrian->id;
+            recorded_locations[p_index] = current;
+            num_events++;
+        }
+
+        if(current_pedestrian->state == GOT_OUT)
+        {
+            if(append_event(current_pedestrian->id - previous_id, TRAJECTORY_EXIT_EVENT) == FAILURE)
+                return;
+
+            previous_id = current_pedestrian->id;
+            recorded_presence[p_index] = false;
+            num_events++;
+        }
+    }
+
+    fputc(TRAJECTORY_TIMESTEP, output_stream);
+    write_varint(output_stream, num_events);
+    fwrite(event_buffer, 1, event_buffer_length, output_stream);
+}
+
+/**
+ * Writes the record that marks the end of a simulation.
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param number_timesteps Number of timesteps required for the termination of the simulation.
+ * @param is_censored Indicates that the simulation was stopped by the watchdog before the environment was empty.
+*/
+void write_trajectory_simulation_end(FILE *output_stream, int number_timesteps, bool is_censored)
+{
+    fputc(is_censored ? TRAJECTORY_CENSORED_END : TRAJECTORY_END, output_stream);
+    write_varint(output_stream, number_timesteps);
+}
+
+/**
+ * Writes the given value as an unsigned LEB128 varint (7 bits per byte, the most significant bit indicating continuation).
+ *
+ * @param output_stream Stream where the data will be written.
+ * @param value Value to be written.
+*/
+void write_varint(FILE *output_stream, unsigned int value)
+{
+    while(value >= 0x80)
+    {
+        fputc((value & 0x7F) | 0x80, output_stream);
+        value >>= 7;
+    }
+    fputc(value, output_stream);
+}
+
+/**
+ * Deallocate the structures used to record the trajectories.
+*/
+void deallocate_trajectory()
+{
+    free(recorded_locations);
+    free(recorded_presence);
+    free(event_buffer);
+
+    recorded_locations = NULL;
+    recorded_presence = NULL;
+    event_buffer = NULL;
+    num_recorded_pedestrians = event_buffer_length = event_buffer_capacity = 0;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Appends an event to the event buffer of the current timestep.
+ *
+ * @param id_gap Difference between the pedestrian id and the id of the previous event.
+ * @param event_code Direction of the movement or TRAJECTORY_EXIT_EVENT.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status append_event(unsigned int id_gap, unsigned char event_code)
+{
+    if(event_buffer_length + 6 > event_buffer_capacity) // A varint of 32 bits takes at most 5 bytes.
+    {
+        int new_capacity = event_buffer_capacity == 0 ? 1024 : event_buffer_capacity * 2;
+        unsigned char *new_buffer = realloc(event_buffer, new_capacity);
+        if(new_buffer == NULL)
+        {
+            fprintf(stderr, "Failure in the realloc of the trajectory event buffer.\n");
+            return FAILURE;
+        }
+
+        event_buffer = new_buffer;
+        event_buffer_capacity = new_capacity;
+    }
+
+    while(id_gap >= 0x80)
+    {
+        event_buffer[event_buffer_length++] = (id_gap & 0x7F) | 0x80;
+        id_gap >>= 7;
+    }
+    event_buffer[event_buffer_length++] = id_gap;
+    event_buffer[event_buffer_length++] = event_code;
+
+    return SUCCESS;
+}
@@ -0,0 +1,103 @@
+/*
+   File: watchdog.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: This module stops the simulations that don't end, which happens when pedestrians are placed in regions without an exit or are stuck in a crowd that never moves. After each timestep, a simulation is censored when it reaches the maximum number of timesteps (--max-timesteps) or when no pedestrian made progress for a number of consecutive timesteps (--stall-timesteps). A pedestrian makes progress when they leave the environment or reach a cell with a lower final floor field value than any they reached before, so a pedestrian that keeps stepping inside a region without an exit stops making progress once they have visited its cells. The best values are kept in the pedestrians and only read and updated here, so the detection costs a pass over the pedestrians only when it is enabled.
+*/
+
+#include<stdlib.h>
+#include<stdbool.h>
+#include<float.h>
+
+#include"../headers/exit.h"
+#include"../headers/pedestrian.h"
+#include"../headers/watchdog.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+static bool has_any_pedestrian_progressed();
+
+/**
+ * Verifies if the simulations can be censored, i.e., if the --max-timesteps or the --stall-timesteps option was given.
+ *
+ * @return bool, where True indicates that the watchdog is enabled.
+*/
+bool is_watchdog_enabled()
+{
+    return cli_args.max_timesteps > 0 || cli_args.stall_timesteps > 0;
+}
+
+/**
+ * Checks the progress of the current simulation after a timestep, determining if it must be censored.
+ *
+ * @note Must be called after every timestep of a simulation whose environment isn't empty yet, so the stall counter follows consecutive timesteps.
+ *
+ * @param number_timesteps Number of timesteps run by the simulation.
+ * @param timesteps_without_progress Number of consecutive timesteps without progress of the simulation (0 at its start), which is updated.
+ * @return enum Censoring_Reason, where NOT_CENSORED indicates that the simulation continues.
+*/
+enum Censoring_Reason check_simulation_progress(int number_timesteps, int *timesteps_without_progress)
+{
+    if(cli_args.stall_timesteps > 0)
+    {
+        if(has_any_pedestrian_progressed())
+            *timesteps_without_progress = 0;
+        else
+            (*timesteps_without_progress)++;
+
+        if(*timesteps_without_progress >= cli_args.stall_timesteps)
+            return SIMULATION_STALLED;
+    }
+
+    if(cli_args.max_timesteps > 0 && number_timesteps >= cli_args.max_timesteps)
+        return TIMESTEP_CAP_REACHED;
+
+    return NOT_CENSORED;
+}
+
+/**
+ * Describes the reason why a simulation was censored.
+ *
+ * @param censoring Reason of the censoring.
+ * @return const char *, with the description (an empty string for NOT_CENSORED).
+*/
+const char *get_censoring_description(enum Censoring_Reason censoring)
+{
+    switch(censoring)
+    {
+        case TIMESTEP_CAP_REACHED:
+            return "maximum number of timesteps reached";
+        case SIMULATION_STALLED:
+            return "no pedestrian made progress";
+        default:
+            return "";
+    }
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Verifies if any pedestrian made progress since the last call, i.e., left the environment or reached a cell with a final floor field value lower than their best one, updating the best values of the pedestrians.
+ *
+ * @return bool, where True indicates that at least one pedestrian made progress.
+*/
+static bool has_any_pedestrian_progressed()
+{
+    bool has_progressed = false;
+
+    for(int p_index = 0; p_index < pedestrian_set.num_pedestrians; p_index++)
+    {
+        Pedestrian current_pedestrian = pedestrian_set.list[p_index];
+
+        double current_value = current_pedestrian->state == GOT_OUT ? -DBL_MAX : exits_set.final_floor_field[current_pedestrian->current.lin][current_pedestrian->current.col];
+        if(current_value < current_pedestrian->best_floor_field_value)
+        {
+            current_pedestrian->best_floor_field_value = current_value;
+            has_progressed = true;
+        }
+    }
+
+    return has_progressed;
+}
@@ -0,0 +1,190 @@
+/*
+   File: panic_gaps.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-19
+   Description: Standalone check of the panic draws. The gaps between the panics drawn by draw_pedestrian_panic (a countdown drawn from a geometric distribution) are compared with the gaps of the per-timestep Bernoulli draws they replace, with and without the common random numbers mode: each sample is compared with the geometric distribution of PANIC_PROBABILITY, and both samples with each other, by chi-square tests. Exits with the number of failed tests, so it can be run after any change to the random streams (see alizadeh_checks.sh).
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdbool.h>
+#include<math.h>
+
+#include"../headers/pedestrian.h"
+#include"../headers/random_stream.h"
+#include"../headers/cli_processing.h"
+#include"../headers/shared_resources.h"
+
+#define NUM_SEEDS 100
+#define NUM_PEDESTRIANS 50
+#define GAPS_PER_PEDESTRIAN 100
+#define NUM_BINS 41 // Gaps from 1 to NUM_BINS - 1, and a last bin with the longer ones.
+#define CHI_SQUARE_CRITICAL_VALUE 73.402 // 99.9% quantile of the chi-square distribution with NUM_BINS - 1 degrees of freedom.
+
+static void sample_gaps(bool is_bernoulli, int first_seed, long *histogram, double *mean_gap);
+static double calculate_goodness_of_fit(long *histogram);
+static double calculate_homogeneity(long *first_histogram, long *second_histogram);
+static bool report_test(const char *name, double statistic);
+
+int main()
+{
+    int failed_tests = 0;
+
+    for(int mode = 0; mode < 2; mode++)
+    {
+        cli_args.common_random_numbers = mode == 1;
+        printf("%s:\n", cli_args.common_random_numbers ? "Substreams of the pedestrians (--common-random-numbers)" : "Global rand() stream");
+
+        long countdown_histogram[NUM_BINS] = {0}, bernoulli_histogram[NUM_BINS] = {0};
+        double countdown_mean, bernoulli_mean;
+
+        sample_gaps(false, 0, countdown_histogram, &countdown_mean);
+        sample_gaps(true, NUM_SEEDS, bernoulli_histogram, &bernoulli_mean); // Other seeds, so both samples are independent.
+
+        printf("\tMean gap: %.4lf (countdown), %.4lf (Bernoulli), %.4lf (expected).\n", countdown_mean, bernoulli_mean, 1.0 / PANIC_PROBABILITY);
+
+        failed_tests += ! report_test("countdown gaps against the geometric distribution", calculate_goodness_of_fit(countdown_histogram));
+        failed_tests += ! report_test("Bernoulli gaps against the geometric distribution", calculate_goodness_of_fit(bernoulli_histogram));
+        failed_tests += ! report_test("countdown gaps against the Bernoulli gaps", calculate_homogeneity(countdown_histogram, bernoulli_histogram));
+    }
+
+    deallocate_random_streams();
+
+    printf("%d failed tests.\n", failed_tests);
+
+    return failed_tests;
+}
+
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+/* ---------------- ---------------- STATIC FUNCTIONS ---------------- ---------------- */
+/* ---------------- ---------------- ---------------- ---------------- ---------------- */
+
+/**
+ * Counts the first GAPS_PER_PEDESTRIAN gaps between the panics of each pedestrian, for every seed. As in the timesteps, the panics of all the pedestrians are drawn at each timestep, in the order of their ids, so the draws of a pedestrian are interleaved with those of the others.
+ *
+ * @param is_bernoulli Indicates that the panics are drawn by a Bernoulli draw at every timestep, instead of draw_pedestrian_panic.
+ * @param first_seed Seed of the first sample.
+ * @param histogram Where the number of gaps of each bin will be added.
+ * @param mean_gap Where the mean gap will be stored.
+*/
+static void sample_gaps(bool is_bernoulli, int first_seed, long *histogram, double *mean_gap)
+{
+    long num_gaps = 0, num_timesteps = 0;
+
+    for(int seed = first_seed; seed < first_seed + NUM_SEEDS; seed++)
+    {
+        srand(seed);
+        reset_random_streams(seed);
+        reserve_random_streams(NUM_PEDESTRIANS);
+
+        struct pedestrian pedestrians[NUM_PEDESTRIANS];
+        int current_gaps[NUM_PEDESTRIANS], completed_gaps[NUM_PEDESTRIANS];
+        for(int p_index = 0; p_index < NUM_PEDESTRIANS; p_index++)
+        {
+            pedestrians[p_index] = (struct pedestrian) {.id = p_index + 1, .timesteps_to_panic = 0};
+            current_gaps[p_index] = completed_gaps[p_index] = 0;
+        }
+
+        int num_complete_pedestrians = 0;
+        while(num_complete_pedestrians < NUM_PEDESTRIANS)
+        {
+            for(int p_index = 0; p_index < NUM_PEDESTRIANS; p_index++)
+            {
+                bool in_panic = is_bernoulli ? (draw_random_integer(p_index + 1, PANIC_STREAM, 100) + 1) / 100.0 <= PANIC_PROBABILITY
+                                             : draw_pedestrian_panic(&pedestrians[p_index]);
+
+                current_gaps[p_index]++;
+                if(in_panic == false)
+                    continue;
+
+                // Only the first gaps are counted, so every counted gap is complete and long gaps aren't cut by the end of the sample.
+                if(completed_gaps[p_index] < GAPS_PER_PEDESTRIAN)
+                {
+                    int gap = current_gaps[p_index];
+                    histogram[gap < NUM_BINS ? gap - 1 : NUM_BINS - 1]++;
+                    num_timesteps += gap;
+                    num_gaps++;
+
+                    if(++completed_gaps[p_index] == GAPS_PER_PEDESTRIAN)
+                        num_complete_pedestrians++;
+                }
+
+                current_gaps[p_index] = 0;
+            }
+        }
+    }
+
+    *mean_gap = (double) num_timesteps / num_gaps;
+}
+
+/**
+ * Calculates the chi-square statistic of the given gaps against the geometric distribution of PANIC_PROBABILITY.
+ *
+ * @param histogram Number of gaps of each bin.
+ * @return The chi-square statistic, with NUM_BINS - 1 degrees of freedom.
+*/
+static double calculate_goodness_of_fit(long *histogram)
+{
+    long num_gaps = 0;
+    for(int bin = 0; bin < NUM_BINS; bin++)
+        num_gaps += histogram[bin];
+
+    double statistic = 0.0, remaining_probability = 1.0;
+    for(int bin = 0; bin < NUM_BINS; bin++)
+    {
+        // The last bin holds every longer gap.
+        double probability = bin < NUM_BINS - 1 ? remaining_probability * PANIC_PROBABILITY : remaining_probability;
+        remaining_probability -= probability;
+
+        double expected = probability * num_gaps;
+        statistic += (histogram[bin] - expected) * (histogram[bin] - expected) / expected;
+    }
+
+    return statistic;
+}
+
+/**
+ * Calculates the chi-square statistic of homogeneity between two samples of gaps.
+ *
+ * @param first_histogram Number of gaps of each bin of the first sample.
+ * @param second_histogram Number of gaps of each bin of the second sample.
+ * @return The chi-square statistic, with NUM_BINS - 1 degrees of freedom.
+*/
+static double calculate_homogeneity(long *first_histogram, long *second_histogram)
+{
+    long first_total = 0, second_total = 0;
+    for(int bin = 0; bin < NUM_BINS; bin++)
+    {
+        first_total += first_histogram[bin];
+        second_total += second_histogram[bin];
+    }
+
+    double statistic = 0.0;
+    for(int bin = 0; bin < NUM_BINS; bin++)
+    {
+        double bin_total = first_histogram[bin] + second_histogram[bin];
+        double first_expected = bin_total * first_total / (first_total + second_total);
+        double second_expected = bin_total * second_total / (first_total + second_total);
+
+        statistic += (first_histogram[bin] - first_expected) * (first_histogram[bin] - first_expected) / first_expected;
+        statistic += (second_histogram[bin] - second_expected) * (second_histogram[bin] - second_expected) / second_expected;
+    }
+
+    return statistic;
+}
+
+/**
+ * Prints the result of a chi-square test.
+ *
+ * @param name Description of the test.
+ * @param statistic Chi-square statistic, with NUM_BINS - 1 degrees of freedom.
+ * @return bool, where True indicates that the test passed.
+*/
+static bool report_test(const char *name, double statistic)
+{
+    bool passed = statistic < CHI_SQUARE_CRITICAL_VALUE;
+
+    printf("\t%s: %s, chi-square of %.2lf (critical value of %.2lf).\n", passed ? "PASSED" : "FAILED", name, statistic, CHI_SQUARE_CRITICAL_VALUE);
+
+    return passed;
+}
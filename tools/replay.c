@@ -0,0 +1,553 @@
+/*
+   File: replay.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: Standalone tool that reads a binary trajectory file (output format 7) and renders all of its frames, extracts a single frame or computes the heatmap of each simulation set offline. Frames and heatmaps are printed in the same layout as the output formats 1 and 3.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+#include<argp.h>
+#include<unistd.h>
+
+#include"../headers/trajectory.h"
+
+enum Replay_Mode {REPLAY_FRAMES, REPLAY_SINGLE_FRAME, REPLAY_HEATMAP};
+
+typedef struct{
+    char trajectory_filename[150];
+    enum Replay_Mode mode;
+    int frame_set;
+    int frame_simulation;
+    int frame_timestep;
+    int delay;
+} Replay_Args;
+
+typedef struct{
+    int line_number;
+    int column_number;
+    unsigned char *cells; // Cell kinds of the environment, in row-major order.
+    bool *exit_cells; // Exit cells of the current simulation set, in row-major order.
+    int *occupancy; // Id of the pedestrian in each cell (0 when empty), in row-major order.
+    long *heatmap; // Visits per cell in the current simulation set, in row-major order.
+    int *pedestrian_cells; // Index of the cell of each pedestrian (-1 after leaving), indexed by id - 1.
+    int num_pedestrians;
+    int set_index;
+    int simulation_index;
+    int simulations_in_set;
+    int timestep;
+} Replay_State;
+
+static error_t replay_parser_function(int key, char *arg, struct argp_state *state);
+static Function_Status read_varint(FILE *trajectory_file, unsigned int *value);
+static Function_Status read_header(FILE *trajectory_file, Replay_State *replay);
+static Function_Status read_set(FILE *trajectory_file, Replay_State *replay);
+static Function_Status read_simulation_start(FILE *trajectory_file, Replay_State *replay);
+static Function_Status read_timestep(FILE *trajectory_file, Replay_State *replay);
+static void accumulate_heatmap(Replay_State *replay);
+static void print_frame(Replay_State *replay);
+static void print_set_heatmap(Replay_State *replay);
+
+const char * argp_program_version = "Replay tool for the binary trajectories of the Alizadeh model implementation.";
+static const char replay_doc[] = "Replay - Renders frames and heatmaps from a binary trajectory file generated with --output-format=7."
+"\v"
+"The trajectory file is searched in the output/ directory. By default, every frame of every simulation is rendered.\n";
+
+#define OPT_FRAME 1000
+#define OPT_HEATMAP 1001
+#define OPT_DELAY 1002
+
+static struct argp_option replay_options[] = {
+    {"frame", OPT_FRAME, "SET:SIMULATION:TIMESTEP", 0, "Renders only the frame of the given simulation set, simulation and timestep (all starting at 0)."},
+    {"heatmap", OPT_HEATMAP, 0, 0, "Prints the heatmap of each simulation set instead of the frames."},
+    {"delay", OPT_DELAY, "MILLISECONDS", 0, "Delay between two rendered frames (default is 0)."},
+    {0}
+};
+
+static struct argp replay_argp = {replay_options, &replay_parser_function, "TRAJECTORY-FILE", replay_doc};
+
+int main(int argc, char **argv)
+{
+    Replay_Args replay_args = {"", REPLAY_FRAMES, 0, 0, 0, 0};
+    Replay_State replay = {0};
+    char complete_path[300] = "";
+
+    if(argp_parse(&replay_argp, argc, argv, 0, 0, &replay_args) != 0)
+        return END_PROGRAM;
+
+    sprintf(complete_path, "output/%s", replay_args.trajectory_filename);
+    FILE *trajectory_file = fopen(complete_path, "rb");
+    if(trajectory_file == NULL)
+    {
+        fprintf(stderr, "It was not possible to open the trajectory file: %s.\n", replay_args.trajectory_filename);
+        return END_PROGRAM;
+    }
+
+    if(read_header(trajectory_file, &replay) == FAILURE)
+        return END_PROGRAM;
+
+    replay.set_index = -1;
+    Replay_Args *args = &replay_args;
+    bool frame_found = false;
+
+    int tag;
+    while((tag = fgetc(trajectory_file)) != EOF)
+    {
+        Function_Status status = SUCCESS;
+
+        switch(tag)
+        {
+            case TRAJECTORY_SET:
+                if(args->mode == REPLAY_HEATMAP && replay.set_index >= 0)
+                    print_set_heatmap(&replay);
+
+                status = read_set(trajectory_file, &replay);
+                break;
+            case TRAJECTORY_SIMULATION:
+                status = read_simulation_start(trajectory_file, &replay);
+                if(args->mode == REPLAY_HEATMAP)
+                    accumulate_heatmap(&replay);
+                break;
+            case TRAJECTORY_TIMESTEP:
+                status = read_timestep(trajectory_file, &replay);
+                if(args->mode == REPLAY_HEATMAP)
+                    accumulate_heatmap(&replay);
+                break;
+            case TRAJECTORY_END:
+            case TRAJECTORY_CENSORED_END:
+            {
+                unsigned int number_timesteps;
+                status = read_varint(trajectory_file, &number_timesteps);
+                if(status == SUCCESS && tag == TRAJECTORY_CENSORED_END && args->mode == REPLAY_FRAMES)
+                    printf("Simulation %d censored after %u timesteps.\n\n", replay.simulation_index, number_timesteps);
+                break;
+            }
+            default:
+                fprintf(stderr, "Unknown record in the trajectory file: %c.\n", tag);
+                status = FAILURE;
+        }
+
+        if(status == FAILURE)
+        {
+            fprintf(stderr, "The trajectory file is corrupted or truncated.\n");
+            return END_PROGRAM;
+        }
+
+        if(tag != TRAJECTORY_SIMULATION && tag != TRAJECTORY_TIMESTEP)
+            continue;
+
+        if(args->mode == REPLAY_FRAMES)
+        {
+            if(args->delay > 0)
+            {
+                printf("\e[1;1H\e[2J");
+                usleep(args->delay * 1000);
+            }
+            print_frame(&replay);
+        }
+        else if(args->mode == REPLAY_SINGLE_FRAME &&
+                replay.set_index == args->frame_set && replay.simulation_index == args->frame_simulation &&
+                replay.timestep == args->frame_timestep)
+        {
+            print_frame(&replay);
+            frame_found = true;
+            break;
+        }
+    }
+
+    if(args->mode == REPLAY_HEATMAP && replay.set_index >= 0)
+        print_set_heatmap(&replay);
+
+    if(args->mode == REPLAY_SINGLE_FRAME && frame_found == false)
+        fprintf(stderr, "The requested frame is not present in the trajectory file.\n");
+
+    fclose(trajectory_file);
+    free(replay.cells);
+    free(replay.exit_cells);
+    free(replay.occupancy);
+    free(replay.heatmap);
+    free(replay.pedestrian_cells);
+
+    return END_PROGRAM;
+}
+
+/**
+ * Called by argp for every option or argument parsed.
+ *
+ * @param key The key field (from the options vector) of the parsed option (ARGP_KEY_ARG for positional arguments).
+ * @param arg Value related to the given key. A 0(NULL) is received if not present.
+ * @param state Useful information about the parsing state.
+ *
+ * @return error_t, where 0 is success, ARGP_ERR_UNKNOWN if the key's value is not handles by this function or an actual error code.
+*/
+static error_t replay_parser_function(int key, char *arg, struct argp_state *state)
+{
+    Replay_Args *replay_args = state->input;
+
+    switch(key)
+    {
+        case OPT_FRAME:
+            if(sscanf(arg, "%d:%d:%d", &replay_args->frame_set, &replay_args->frame_simulation, &replay_args->frame_timestep) != 3)
+            {
+                fprintf(stderr, "The frame must be given as SET:SIMULATION:TIMESTEP.\n");
+                return EIO;
+            }
+            replay_args->mode = REPLAY_SINGLE_FRAME;
+            break;
+        case OPT_HEATMAP:
+            replay_args->mode = REPLAY_HEATMAP;
+            break;
+        case OPT_DELAY:
+            replay_args->delay = atoi(arg);
+            if(replay_args->delay < 0)
+            {
+                fprintf(stderr, "The delay must be non-negative.\n");
+                return EIO;
+            }
+            break;
+        case ARGP_KEY_ARG:
+            if(state->arg_num > 0)
+            {
+                fprintf(stderr, "A single trajectory file was expected.\n");
+                return EINVAL;
+            }
+            strncpy(replay_args->trajectory_filename, arg, sizeof(replay_args->trajectory_filename) - 1);
+            break;
+        case ARGP_KEY_END:
+            if(state->arg_num == 0)
+            {
+                fprintf(stderr, "No trajectory file was provided.\n");
+                return EINVAL;
+            }
+            break;
+        default:
+            return ARGP_ERR_UNKNOWN;
+    }
+
+    return 0;
+}
+
+/**
+ * Reads an unsigned LEB128 varint from the trajectory file.
+ *
+ * @param trajectory_file File being read.
+ * @param value Pointer to where the value will be stored.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_varint(FILE *trajectory_file, unsigned int *value)
+{
+    *value = 0;
+    for(int shift = 0; shift < 35; shift += 7)
+    {
+        int read_byte = fgetc(trajectory_file);
+        if(read_byte == EOF)
+            return FAILURE;
+
+        *value |= (unsigned int) (read_byte & 0x7F) << shift;
+        if((read_byte & 0x80) == 0)
+            return SUCCESS;
+    }
+
+    return FAILURE;
+}
+
+/**
+ * Reads the header of the trajectory file, allocating the structures of the replay and printing the full command in the same layout as the simulation program.
+ *
+ * @param trajectory_file File being read.
+ * @param replay Replay state to be initialized.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_header(FILE *trajectory_file, Replay_State *replay)
+{
+    char magic[5] = "";
+    unsigned int version, command_length, line_number, column_number;
+
+    if(fread(magic, 1, 4, trajectory_file) != 4 || strcmp(magic, TRAJECTORY_MAGIC) != 0)
+    {
+        fprintf(stderr, "The provided file isn't a trajectory file.\n");
+        return FAILURE;
+    }
+
+    if(read_varint(trajectory_file, &version) == FAILURE || version < 1 || version > TRAJECTORY_VERSION) // Version 1 files have no censored records.
+    {
+        fprintf(stderr, "Unsupported trajectory file version.\n");
+        return FAILURE;
+    }
+
+    if(read_varint(trajectory_file, &command_length) == FAILURE)
+        return FAILURE;
+
+    char *full_command = calloc(command_length + 1, 1);
+    if(full_command == NULL || fread(full_command, 1, command_length, trajectory_file) != command_length)
+    {
+        fprintf(stderr, "Failure while reading the full command of the trajectory file.\n");
+        free(full_command);
+        return FAILURE;
+    }
+
+    if(read_varint(trajectory_file, &line_number) == FAILURE || read_varint(trajectory_file, &column_number) == FAILURE ||
+       line_number == 0 || column_number == 0)
+    {
+        fprintf(stderr, "Invalid environment dimensions in the trajectory file.\n");
+        free(full_command);
+        return FAILURE;
+    }
+
+    replay->line_number = line_number;
+    replay->column_number = column_number;
+
+    int num_cells = line_number * column_number;
+    replay->cells = malloc(num_cells);
+    replay->exit_cells = calloc(num_cells, sizeof(bool));
+    replay->occupancy = calloc(num_cells, sizeof(int));
+    replay->heatmap = calloc(num_cells, sizeof(long));
+    if(replay->cells == NULL || replay->exit_cells == NULL || replay->occupancy == NULL || replay->heatmap == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the replay grids with dimensions: %d x %d.\n", line_number, column_number);
+        free(full_command);
+        return FAILURE;
+    }
+
+    if(fread(replay->cells, 1, num_cells, trajectory_file) != (size_t) num_cells)
+    {
+        fprintf(stderr, "Failure while reading the environment of the trajectory file.\n");
+        free(full_command);
+        return FAILURE;
+    }
+
+    printf("./alizadeh.sh%s", full_command);
+    printf("\n--------------------------------------------------------------\n\n");
+    free(full_command);
+
+    return SUCCESS;
+}
+
+/**
+ * Reads a simulation set record, replacing the exit cells of the replay.
+ *
+ * @param trajectory_file File being read.
+ * @param replay Replay state.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_set(FILE *trajectory_file, Replay_State *replay)
+{
+    unsigned int num_exit_cells, line, column;
+    int num_cells = replay->line_number * replay->column_number;
+
+    memset(replay->exit_cells, 0, sizeof(bool) * num_cells);
+    memset(replay->heatmap, 0, sizeof(long) * num_cells);
+    replay->set_index++;
+    replay->simulation_index = -1;
+    replay->simulations_in_set = 0;
+
+    if(read_varint(trajectory_file, &num_exit_cells) == FAILURE)
+        return FAILURE;
+
+    for(unsigned int cell_index = 0; cell_index < num_exit_cells; cell_index++)
+    {
+        if(read_varint(trajectory_file, &line) == FAILURE || read_varint(trajectory_file, &column) == FAILURE)
+            return FAILURE;
+
+        if(line >= (unsigned int) replay->line_number || column >= (unsigned int) replay->column_number)
+            return FAILURE;
+
+        replay->exit_cells[line * replay->column_number + column] = true;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Reads a simulation record, placing every pedestrian at its initial position.
+ *
+ * @param trajectory_file File being read.
+ * @param replay Replay state.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_simulation_start(FILE *trajectory_file, Replay_State *replay)
+{
+    unsigned int simulation_index, num_pedestrians, line, column;
+
+    if(read_varint(trajectory_file, &simulation_index) == FAILURE || read_varint(trajectory_file, &num_pedestrians) == FAILURE)
+        return FAILURE;
+
+    int *new_cells = realloc(replay->pedestrian_cells, sizeof(int) * (num_pedestrians > 0 ? num_pedestrians : 1));
+    if(new_cells == NULL)
+        return FAILURE;
+
+    replay->pedestrian_cells = new_cells;
+    replay->num_pedestrians = num_pedestrians;
+    replay->simulation_index = simulation_index;
+    replay->simulations_in_set++;
+    replay->timestep = 0;
+
+    memset(replay->occupancy, 0, sizeof(int) * replay->line_number * replay->column_number);
+
+    for(unsigned int p_index = 0; p_index < num_pedestrians; p_index++)
+    {
+        if(read_varint(trajectory_file, &line) == FAILURE || read_varint(trajectory_file, &column) == FAILURE)
+            return FAILURE;
+
+        if(line >= (unsigned int) replay->line_number || column >= (unsigned int) replay->column_number)
+            return FAILURE;
+
+        int cell = line * replay->column_number + column;
+        replay->pedestrian_cells[p_index] = cell;
+        replay->occupancy[cell] = p_index + 1;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Reads a timestep record, applying the movements and exits of the pedestrians.
+ *
+ * @param trajectory_file File being read.
+ * @param replay Replay state.
+ * @return Function_Status: FAILURE (0) or SUCCESS (1).
+*/
+static Function_Status read_timestep(FILE *trajectory_file, Replay_State *replay)
+{
+    unsigned int num_events, id_gap;
+    int pedestrian_id = 0;
+
+    if(read_varint(trajectory_file, &num_events) == FAILURE)
+        return FAILURE;
+
+    // Cells vacated in this timestep are cleared before the new positions are written, as pedestrians can move into a cell
+    // left by another pedestrian with a larger id.
+    int *moved_cells = malloc(sizeof(int) * (num_events > 0 ? num_events : 1));
+    int *moved_ids = malloc(sizeof(int) * (num_events > 0 ? num_events : 1));
+    int num_moved = 0;
+    if(moved_cells == NULL || moved_ids == NULL)
+    {
+        free(moved_cells);
+        free(moved_ids);
+        return FAILURE;
+    }
+
+    Function_Status status = SUCCESS;
+    for(unsigned int event_index = 0; event_index < num_events; event_index++)
+    {
+        int event_code = EOF;
+        if(read_varint(trajectory_file, &id_gap) == FAILURE || (event_code = fgetc(trajectory_file)) == EOF)
+        {
+            status = FAILURE;
+            break;
+        }
+
+        pedestrian_id += id_gap;
+        if(pedestrian_id < 1 || pedestrian_id > replay->num_pedestrians || replay->pedestrian_cells[pedestrian_id - 1] == -1)
+        {
+            status = FAILURE;
+            break;
+        }
+
+        int *cell = &replay->pedestrian_cells[pedestrian_id - 1];
+        if(replay->occupancy[*cell] == pedestrian_id)
+            replay->occupancy[*cell] = 0;
+
+        if(event_code == TRAJECTORY_EXIT_EVENT)
+        {
+            *cell = -1;
+            continue;
+        }
+
+        int line = *cell / replay->column_number + event_code / 3 - 1;
+        int column = *cell % replay->column_number + event_code % 3 - 1;
+        if(event_code > 8 || line < 0 || line >= replay->line_number || column < 0 || column >= replay->column_number)
+        {
+            status = FAILURE;
+            break;
+        }
+
+        *cell = line * replay->column_number + column;
+        moved_cells[num_moved] = *cell;
+        moved_ids[num_moved] = pedestrian_id;
+        num_moved++;
+    }
+
+    for(int moved_index = 0; moved_index < num_moved; moved_index++)
+    {
+        if(replay->pedestrian_cells[moved_ids[moved_index] - 1] == moved_cells[moved_index])
+            replay->occupancy[moved_cells[moved_index]] = moved_ids[moved_index];
+    }
+
+    free(moved_cells);
+    free(moved_ids);
+
+    replay->timestep++;
+
+    return status;
+}
+
+/**
+ * Adds the current position of every pedestrian still in the environment to the heatmap.
+ *
+ * @param replay Replay state.
+*/
+static void accumulate_heatmap(Replay_State *replay)
+{
+    for(int p_index = 0; p_index < replay->num_pedestrians; p_index++)
+    {
+        if(replay->pedestrian_cells[p_index] != -1)
+            replay->heatmap[replay->pedestrian_cells[p_index]]++;
+    }
+}
+
+/**
+ * Prints the current frame in the same layout used by the visualization output format.
+ *
+ * @param replay Replay state.
+*/
+static void print_frame(Replay_State *replay)
+{
+    printf("Simulation %d - timestep %d\n\n", replay->simulation_index, replay->timestep);
+
+    for(int i = 0; i < replay->line_number; i++)
+    {
+        for(int h = 0; h < replay->column_number; h++)
+        {
+            int cell = i * replay->column_number + h;
+
+            if(replay->occupancy[cell] != 0)
+                printf("👤");
+            else if(replay->exit_cells[cell])
+                printf("🚪");
+            else if(replay->cells[cell] == TRAJECTORY_WALL_CELL)
+                printf("🧱");
+            else
+                printf("⬛");
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+/**
+ * Prints the heatmap of the current simulation set in the same layout used by the heatmap output format.
+ *
+ * @note Unlike the heatmap output format, the initial positions of static pedestrians are counted in every simulation.
+ *
+ * @param replay Replay state.
+*/
+static void print_set_heatmap(Replay_State *replay)
+{
+    if(replay->simulations_in_set == 0)
+    {
+        printf("At least one exit from the simulation set is inaccessible.\n");
+        return;
+    }
+
+    for(int i = 0; i < replay->line_number; i++)
+    {
+        for(int h = 0; h < replay->column_number; h++)
+            printf("%.2lf ", (double) replay->heatmap[i * replay->column_number + h] / (double) replay->simulations_in_set);
+
+        printf("\n");
+    }
+    printf("\n");
+}
@@ -0,0 +1,275 @@
+/*
+   File: viewer.c
+   Author: Daniel Gonçalves
+   Date: 2026-10-18
+   Description: Standalone tool that watches the simulations published with the --live-stream option. The shared memory ring buffer is read without locks: the most recent complete frame is rendered at each refresh and frames overwritten in the meantime are skipped.
+*/
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdbool.h>
+#include<argp.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+#include"../headers/live_stream.h"
+
+typedef struct{
+    char shared_memory_name[150];
+    int refresh;
+} Viewer_Args;
+
+static error_t viewer_parser_function(int key, char *arg, struct argp_state *state);
+static unsigned char *map_live_stream(char *shared_memory_name, size_t *shared_memory_size);
+static bool copy_latest_frame(unsigned char *shared_memory, unsigned char *frame, size_t frame_size, uint64_t *frame_number);
+static void print_frame(Live_Stream_Header *header, unsigned char *frame, uint64_t frame_number, uint64_t skipped_frames);
+
+const char * argp_program_version = "Live viewer for the Alizadeh model implementation.";
+static const char viewer_doc[] = "Viewer - Renders the frames published by a simulation started with the --live-stream option."
+"\v"
+"The viewer can be started before the simulation, in which case it waits for the shared memory object to be created. It ends when the simulation program ends.\n";
+
+#define OPT_REFRESH 1000
+
+static struct argp_option viewer_options[] = {
+    {"refresh", OPT_REFRESH, "MILLISECONDS", 0, "Interval between two renderings (default is 100)."},
+    {0}
+};
+
+static struct argp viewer_argp = {viewer_options, &viewer_parser_function, "[SHM-NAME]", viewer_doc};
+
+int main(int argc, char **argv)
+{
+    Viewer_Args viewer_args = {LIVE_STREAM_DEFAULT_NAME, 100};
+    size_t shared_memory_size = 0;
+
+    if(argp_parse(&viewer_argp, argc, argv, 0, 0, &viewer_args) != 0)
+        return END_PROGRAM;
+
+    unsigned char *shared_memory = map_live_stream(viewer_args.shared_memory_name, &shared_memory_size);
+    if(shared_memory == NULL)
+        return END_PROGRAM;
+
+    Live_Stream_Header *header = (Live_Stream_Header *) shared_memory;
+    size_t frame_size = live_stream_slot_size(header->line_number, header->column_number);
+    unsigned char *frame = malloc(frame_size);
+    if(frame == NULL)
+    {
+        fprintf(stderr, "Failure during the allocation of the frame buffer.\n");
+        munmap(shared_memory, shared_memory_size);
+        return END_PROGRAM;
+    }
+
+    uint64_t last_frame = 0;
+    uint64_t skipped_frames = 0;
+    while(true)
+    {
+        bool finished = atomic_load(&header->finished) != 0;
+        uint64_t frame_number = last_frame;
+
+        if(copy_latest_frame(shared_memory, frame, frame_size, &frame_number) && frame_number != last_frame)
+        {
+            skipped_frames += frame_number - last_frame - 1;
+            print_frame(header, frame, frame_number, skipped_frames);
+            last_frame = frame_number;
+        }
+
+        if(finished && last_frame == atomic_load(&header->latest_frame))
+            break;
+
+        usleep(viewer_args.refresh * 1000);
+    }
+
+    free(frame);
+    munmap(shared_memory, shared_memory_size);
+
+    return END_PROGRAM;
+}
+
+/**
+ * Called by argp for every option or argument parsed.
+ *
+ * @param key The key field (from the options vector) of the parsed option (ARGP_KEY_ARG for positional arguments).
+ * @param arg Value related to the given key. A 0(NULL) is received if not present.
+ * @param state Useful information about the parsing state.
+ *
+ * @return error_t, where 0 is success, ARGP_ERR_UNKNOWN if the key's value is not handles by this function or an actual error code.
+*/
+static error_t viewer_parser_function(int key, char *arg, struct argp_state *state)
+{
+    Viewer_Args *viewer_args = state->input;
+
+    switch(key)
+    {
+        case OPT_REFRESH:
+            viewer_args->refresh = atoi(arg);
+            if(viewer_args->refresh <= 0)
+            {
+                fprintf(stderr, "The refresh interval must be positive.\n");
+                return EIO;
+            }
+            break;
+        case ARGP_KEY_ARG:
+            if(state->arg_num > 0 || strlen(arg) == 0 || strlen(arg) > 140)
+            {
+                fprintf(stderr, "A single valid shared memory name was expected.\n");
+                return EINVAL;
+            }
+            sprintf(viewer_args->shared_memory_name, "%s%s", arg[0] == '/' ? "" : "/", arg);
+            break;
+        default:
+            return ARGP_ERR_UNKNOWN;
+    }
+
+    return 0;
+}
+
+/**
+ * Waits until the shared memory object exists and its header is initialized, then maps it entirely for reading.
+ *
+ * @param shared_memory_name Name of the shared memory object.
+ * @param shared_memory_size Pointer to where the size of the mapping will be stored.
+ * @return Pointer to the mapped shared memory or NULL on failure.
+*/
+static unsigned char *map_live_stream(char *shared_memory_name, size_t *shared_memory_size)
+{
+    bool waiting_message_printed = false;
+
+    while(true)
+    {
+        int shared_memory_descriptor = shm_open(shared_memory_name, O_RDONLY, 0);
+        struct stat shared_memory_status;
+
+        if(shared_memory_descriptor != -1 && fstat(shared_memory_descriptor, &shared_memory_status) == 0 &&
+           shared_memory_status.st_size >= LIVE_STREAM_HEADER_SIZE)
+        {
+            Live_Stream_Header *header = mmap(NULL, LIVE_STREAM_HEADER_SIZE, PROT_READ, MAP_SHARED, shared_memory_descriptor, 0);
+
+            if(header != MAP_FAILED && memcmp(header->magic, LIVE_STREAM_MAGIC, sizeof(header->magic)) == 0)
+            {
+                atomic_thread_fence(memory_order_acquire);
+
+                if(header->version != LIVE_STREAM_VERSION || header->num_slots != LIVE_STREAM_SLOTS)
+                {
+                    fprintf(stderr, "Unsupported live stream version.\n");
+                    munmap(header, LIVE_STREAM_HEADER_SIZE);
+                    close(shared_memory_descriptor);
+                    return NULL;
+                }
+
+                *shared_memory_size = LIVE_STREAM_HEADER_SIZE + live_stream_slot_size(header->line_number, header->column_number) * LIVE_STREAM_SLOTS;
+                munmap(header, LIVE_STREAM_HEADER_SIZE);
+
+                unsigned char *shared_memory = mmap(NULL, *shared_memory_size, PROT_READ, MAP_SHARED, shared_memory_descriptor, 0);
+                close(shared_memory_descriptor);
+                if(shared_memory == MAP_FAILED)
+                {
+                    fprintf(stderr, "It was not possible to map the shared memory object: %s.\n", shared_memory_name);
+                    return NULL;
+                }
+
+                return shared_memory;
+            }
+
+            if(header != MAP_FAILED)
+                munmap(header, LIVE_STREAM_HEADER_SIZE);
+        }
+
+        if(shared_memory_descriptor != -1)
+            close(shared_memory_descriptor);
+
+        if(! waiting_message_printed)
+        {
+            fprintf(stderr, "Waiting for the live stream %s.\n", shared_memory_name);
+            waiting_message_printed = true;
+        }
+
+        usleep(100 * 1000);
+    }
+}
+
+/**
+ * Copies the most recent complete frame of the ring buffer, retrying if the writer reuses its slot during the copy.
+ *
+ * @param shared_memory Mapped shared memory.
+ * @param frame Buffer where the slot will be copied.
+ * @param frame_size Size of the slot.
+ * @param frame_number Pointer to where the number of the copied frame will be stored.
+ * @return true if a frame was copied, false if no frame was published yet.
+*/
+static bool copy_latest_frame(unsigned char *shared_memory, unsigned char *frame, size_t frame_size, uint64_t *frame_number)
+{
+    Live_Stream_Header *header = (Live_Stream_Header *) shared_memory;
+
+    while(true)
+    {
+        uint64_t latest_frame = atomic_load_explicit(&header->latest_frame, memory_order_acquire);
+        if(latest_frame == 0)
+            return false;
+
+        if(latest_frame == *frame_number)
+            return true;
+
+        unsigned char *slot = shared_memory + LIVE_STREAM_HEADER_SIZE + frame_size * ((latest_frame - 1) % LIVE_STREAM_SLOTS);
+        Live_Frame_Header *slot_header = (Live_Frame_Header *) slot;
+
+        uint64_t sequence_before = atomic_load_explicit(&slot_header->sequence, memory_order_acquire);
+        if(sequence_before != 2 * latest_frame)
+            continue; // The slot was already reused by a newer frame.
+
+        memcpy(frame + sizeof(Live_Frame_Header), slot + sizeof(Live_Frame_Header), frame_size - sizeof(Live_Frame_Header));
+        memcpy(frame + sizeof(_Atomic uint64_t), slot + sizeof(_Atomic uint64_t), sizeof(Live_Frame_Header) - sizeof(_Atomic uint64_t));
+        atomic_thread_fence(memory_order_acquire);
+
+        if(atomic_load_explicit(&slot_header->sequence, memory_order_relaxed) == sequence_before)
+        {
+            *frame_number = latest_frame;
+            return true;
+        }
+    }
+}
+
+/**
+ * Prints a frame in the same layout used by the visualization output format.
+ *
+ * @param header Header of the live stream.
+ * @param frame Copied slot of the frame.
+ * @param frame_number Number of the frame.
+ * @param skipped_frames Total of frames published but not rendered.
+*/
+static void print_frame(Live_Stream_Header *header, unsigned char *frame, uint64_t frame_number, uint64_t skipped_frames)
+{
+    Live_Frame_Header *frame_header = (Live_Frame_Header *) frame;
+    unsigned char *cells = frame + sizeof(Live_Frame_Header);
+
+    printf("\e[1;1H\e[2J");
+    printf("Simulation set %u - simulation %u - timestep %u\n", frame_header->set_index, frame_header->simulation_index, frame_header->timestep);
+    printf("Pedestrians: %u - frame %lu (%lu skipped)\n\n", frame_header->num_pedestrians, (unsigned long) frame_number, (unsigned long) skipped_frames);
+
+    for(uint32_t i = 0; i < header->line_number; i++)
+    {
+        for(uint32_t h = 0; h < header->column_number; h++)
+        {
+            switch(cells[i * header->column_number + h])
+            {
+                case LIVE_PEDESTRIAN_CELL:
+                    printf("👤");
+                    break;
+                case LIVE_EXIT_CELL:
+                    printf("🚪");
+                    break;
+                case LIVE_WALL_CELL:
+                    printf("🧱");
+                    break;
+                default:
+                    printf("⬛");
+            }
+        }
+        printf("\n");
+    }
+    printf("\n");
+    fflush(stdout);
+}
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+gcc -o build/viewer.exe tools/viewer.c -g && ./build/viewer.exe "$@"